@@ -0,0 +1,124 @@
+#include "xIFO.h"
+#include "unity_cpp.h"
+#include <vector>
+
+#if xIFO_USE_COROUTINE == TRUE
+#define ELEMENTS    1000
+#define STAGES      100000
+
+/* Fire and forget coroutine, frees itself at the end */
+struct task {
+    struct promise_type {
+        task get_return_object(){ return task(); }
+        std::suspend_never initial_suspend(){ return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void(){}
+        void unhandled_exception(){ std::terminate(); }
+    };
+};
+
+static uint32_t received;
+static uint32_t wrong;
+static bool produced;
+
+static task producer(XifoAsync<uint32_t> &q)
+{
+    for(uint32_t i = 1; i <= ELEMENTS; i++){
+        co_await q.async_write(i);
+    }
+    produced = true;
+}
+
+static task consumer(XifoAsync<uint32_t> &q)
+{
+    for(uint32_t i = 1; i <= ELEMENTS; i++){
+        uint32_t v = co_await q.async_pop_lr();
+        if(v != i){
+            wrong++;
+        }
+        received++;
+    }
+}
+
+void testAsyncInlineResume(void)
+{
+    XifoAsync<uint32_t> q(4);
+    received = 0;
+    wrong = 0;
+    produced = false;
+    /* Consumer suspends on the empty buffer, producer on the full one */
+    consumer(q);
+    producer(q);
+    TEST_ASSERT_TRUE(produced);
+    TEST_ASSERT_EQUAL((uint32_t)ELEMENTS, received);
+    TEST_ASSERT_EQUAL(0u, wrong);
+    TEST_ASSERT_EQUAL(0u, q.used());
+}
+
+static task stage(XifoAsync<uint32_t> &in, XifoAsync<uint32_t> &out)
+{
+    uint32_t v = co_await in.async_pop_lr();
+    co_await out.async_write(v + 1);
+}
+
+void testAsyncLongChainFlatStack(void)
+{
+    std::vector<XifoAsync<uint32_t> *> line;
+    uint32_t v = 0;
+    for(uint32_t i = 0; i <= STAGES; i++){
+        line.push_back(new XifoAsync<uint32_t>(1));
+    }
+    for(uint32_t i = 0; i < STAGES; i++){
+        stage(*line[i], *line[i + 1]);
+    }
+    /* Every stage wakes the next one, nested resumes would blow the stack */
+    TEST_ASSERT_TRUE(line[0]->try_write(0));
+    TEST_ASSERT_TRUE(line[STAGES]->try_pop_lr(v));
+    TEST_ASSERT_EQUAL((uint32_t)STAGES, v);
+    for(uint32_t i = 0; i <= STAGES; i++){
+        delete line[i];
+    }
+}
+
+static void post(std::coroutine_handle<> h, void *ctx)
+{
+    ((std::vector<std::coroutine_handle<> > *)ctx)->push_back(h);
+}
+
+void testAsyncExecutorResume(void)
+{
+    std::vector<std::coroutine_handle<> > ready;
+    XifoAsync<uint32_t> q(4, post, &ready);
+    uint32_t v;
+    received = 0;
+    wrong = 0;
+    produced = false;
+    producer(q);
+    consumer(q);
+    /* The executor loop resumes whatever the buffer handed over */
+    while(!ready.empty()){
+        std::coroutine_handle<> h = ready.front();
+        ready.erase(ready.begin());
+        h.resume();
+    }
+    TEST_ASSERT_TRUE(produced);
+    TEST_ASSERT_EQUAL((uint32_t)ELEMENTS, received);
+    TEST_ASSERT_EQUAL(0u, wrong);
+    TEST_ASSERT_FALSE(q.try_pop_lr(v));
+    TEST_ASSERT_TRUE(q.try_write(7));
+    TEST_ASSERT_TRUE(q.try_pop_lr(v));
+    TEST_ASSERT_EQUAL(7u, v);
+}
+#endif
+
+int main(void)
+{
+#if xIFO_USE_COROUTINE == TRUE
+    RUN_TEST(testAsyncInlineResume);
+    RUN_TEST(testAsyncExecutorResume);
+    RUN_TEST(testAsyncLongChainFlatStack);
+#else
+    printf("test_async.cpp: needs C++20 coroutines, skipped\n");
+#endif
+    return UNITY_END();
+}
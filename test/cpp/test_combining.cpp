@@ -0,0 +1,51 @@
+#include "xIFO.h"
+#include "unity_cpp.h"
+
+#define THREADS     6
+#define PER_THREAD  20000
+
+static XifoCombining<uint32_t> *comb;
+static std::atomic<uint64_t> popped;
+
+static void producer(uint32_t id)
+{
+    for(uint32_t i = 1; i <= PER_THREAD; i++){
+        comb->write(id * PER_THREAD + i);
+        /* Pop every other time, the buffer never overwrites */
+        uint32_t v;
+        if((i & 1) == 0 && comb->pop_lr(v)){
+            popped.fetch_add(v, std::memory_order_relaxed);
+        }
+    }
+}
+
+void testCombiningSumMatches(void)
+{
+    std::thread t[THREADS];
+    uint64_t written = 0;
+    uint32_t v;
+    /* Fewer slots than threads, exercises the slot claim */
+    comb = new XifoCombining<uint32_t>(THREADS * PER_THREAD, THREADS - 2);
+    popped.store(0);
+    for(uint32_t i = 0; i < THREADS; i++){
+        t[i] = std::thread(producer, i);
+    }
+    for(uint32_t i = 0; i < THREADS; i++){
+        t[i].join();
+        for(uint32_t j = 1; j <= PER_THREAD; j++){
+            written += i * PER_THREAD + j;
+        }
+    }
+    while(comb->pop_mr(v)){
+        popped.fetch_add(v, std::memory_order_relaxed);
+    }
+    TEST_ASSERT_EQUAL(written, popped.load());
+    TEST_ASSERT_FALSE(comb->pop_lr(v));
+    delete comb;
+}
+
+int main(void)
+{
+    RUN_TEST(testCombiningSumMatches);
+    return UNITY_END();
+}
@@ -0,0 +1,94 @@
+#include "xIFO.h"
+#include "unity_cpp.h"
+
+#define PRODUCERS   3
+#define CONSUMERS   3
+#define PER_THREAD  30000
+
+static XifoMpmc<uint32_t> *q;
+static std::atomic<uint64_t> popped;
+static std::atomic<uint32_t> count;
+
+static void producer(uint32_t id, bool wait)
+{
+    for(uint32_t i = 1; i <= PER_THREAD; i++){
+        uint32_t v = id * PER_THREAD + i;
+        if(wait){
+            q->write_wait(v);
+        }else{
+            while(!q->try_write(v)){
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+static void consumer(bool wait)
+{
+    uint32_t v;
+    while(count.load(std::memory_order_relaxed) < PRODUCERS * PER_THREAD){
+        if(wait ? q->pop_lr_wait(v, 10) : q->try_pop_lr(v)){
+            popped.fetch_add(v, std::memory_order_relaxed);
+            count.fetch_add(1, std::memory_order_relaxed);
+        }else if(!wait){
+            std::this_thread::yield();
+        }
+    }
+}
+
+static void run(bool wait)
+{
+    std::thread p[PRODUCERS], c[CONSUMERS];
+    uint64_t written = 0;
+    q = new XifoMpmc<uint32_t>(64);
+    popped.store(0);
+    count.store(0);
+    for(uint32_t i = 0; i < CONSUMERS; i++){
+        c[i] = std::thread(consumer, wait);
+    }
+    for(uint32_t i = 0; i < PRODUCERS; i++){
+        p[i] = std::thread(producer, i, wait);
+    }
+    for(uint32_t i = 0; i < PRODUCERS; i++){
+        p[i].join();
+        for(uint32_t j = 1; j <= PER_THREAD; j++){
+            written += i * PER_THREAD + j;
+        }
+    }
+    for(uint32_t i = 0; i < CONSUMERS; i++){
+        c[i].join();
+    }
+    TEST_ASSERT_EQUAL(written, popped.load());
+    TEST_ASSERT_EQUAL(0u, q->used());
+    delete q;
+}
+
+void testMpmcTrySumMatches(void)
+{
+    run(false);
+}
+
+void testMpmcWaitSumMatches(void)
+{
+    run(true);
+}
+
+void testMpmcWaitTimesOut(void)
+{
+    XifoMpmc<uint32_t> small(2);
+    uint32_t v;
+    TEST_ASSERT_FALSE(small.pop_lr_wait(v, 5));
+    TEST_ASSERT_TRUE(small.write_wait(1, 0));
+    TEST_ASSERT_TRUE(small.write_wait(2, 0));
+    TEST_ASSERT_FALSE(small.write_wait(3, 5));
+    TEST_ASSERT_TRUE(small.pop_lr_wait(v, 0));
+    TEST_ASSERT_EQUAL(1u, v);
+}
+
+int main(void)
+{
+    RUN_TEST(testMpmcTrySumMatches);
+    RUN_TEST(testMpmcWaitSumMatches);
+    RUN_TEST(testMpmcWaitTimesOut);
+    return UNITY_END();
+}
@@ -0,0 +1,98 @@
+#include "xIFO.h"
+#include "unity_cpp.h"
+
+#define ELEMENTS    100000
+
+static XifoPipeline<uint32_t, 2> *line;
+static uint32_t received;
+static uint32_t wrong;
+
+static void producer(void)
+{
+    uint32_t next = 1;
+    while(next <= ELEMENTS){
+        if(next & 1){
+            /* Single element */
+            if(!line->write(next)){
+                std::this_thread::yield();
+                continue;
+            }
+            next++;
+        }else{
+            /* Batch of slots written in place */
+            uint32_t n = 7;
+            uint32_t *p = line->claim(n);
+            if(n == 0){
+                std::this_thread::yield();
+                continue;
+            }
+            if(n > ELEMENTS + 1 - next){
+                n = ELEMENTS + 1 - next;
+            }
+            for(uint32_t i = 0; i < n; i++){
+                p[i] = next++;
+            }
+            line->publish(n);
+        }
+    }
+}
+
+/* Stage 0 transforms in place */
+static void stage0(void)
+{
+    uint32_t done = 0;
+    while(done < ELEMENTS){
+        uint32_t n = 16;
+        uint32_t *p = line->peek(0, n);
+        if(n == 0){
+            std::this_thread::yield();
+            continue;
+        }
+        for(uint32_t i = 0; i < n; i++){
+            p[i] *= 3;
+        }
+        line->release(0, n);
+        done += n;
+    }
+}
+
+/* Stage 1 checks order and value */
+static void stage1(void)
+{
+    while(received < ELEMENTS){
+        uint32_t n = 1000;
+        uint32_t *p = line->peek(1, n);
+        if(n == 0){
+            std::this_thread::yield();
+            continue;
+        }
+        for(uint32_t i = 0; i < n; i++){
+            received++;
+            if(p[i] != received * 3){
+                wrong++;
+            }
+        }
+        line->release(1, n);
+    }
+}
+
+void testPipelineKeepsOrderThroughStages(void)
+{
+    line = new XifoPipeline<uint32_t, 2>(64);
+    received = 0;
+    wrong = 0;
+    std::thread s1(stage1), s0(stage0), p(producer);
+    p.join();
+    s0.join();
+    s1.join();
+    TEST_ASSERT_EQUAL((uint32_t)ELEMENTS, received);
+    TEST_ASSERT_EQUAL(0u, wrong);
+    TEST_ASSERT_EQUAL(0u, line->used());
+    delete line;
+}
+
+int main(void)
+{
+    RUN_TEST(testPipelineKeepsOrderThroughStages);
+    return UNITY_END();
+}
@@ -0,0 +1,50 @@
+#include "xIFO.h"
+#include "unity_cpp.h"
+
+static std::atomic<uint32_t> ran;
+static XifoScheduler *sched;
+
+static void leaf(void *arg)
+{
+    ran.fetch_add((uint32_t)(uintptr_t)arg, std::memory_order_relaxed);
+}
+
+/* Runs on a worker, submits to its own deque */
+static void fork(void *arg)
+{
+    sched->submit(leaf, arg);
+    sched->submit(leaf, arg);
+}
+
+void testSchedulerRunsAllTasks(void)
+{
+    ran.store(0);
+    sched = new XifoScheduler(4, 64);
+    for(uint32_t i = 0; i < 10000; i++){
+        sched->submit(leaf, (void *)1);
+    }
+    sched->wait();
+    TEST_ASSERT_EQUAL(10000u, ran.load());
+    delete sched;
+}
+
+void testSchedulerDestroyWhileStealing(void)
+{
+    /* Workers are idle stealing when the destructor runs */
+    for(uint32_t round = 0; round < 200; round++){
+        ran.store(0);
+        sched = new XifoScheduler(4, 64);
+        for(uint32_t i = 0; i < 500; i++){
+            sched->submit(fork, (void *)1);
+        }
+        delete sched;
+        TEST_ASSERT_EQUAL(1000u, ran.load());
+    }
+}
+
+int main(void)
+{
+    RUN_TEST(testSchedulerRunsAllTasks);
+    RUN_TEST(testSchedulerDestroyWhileStealing);
+    return UNITY_END();
+}
@@ -0,0 +1,62 @@
+#include "xIFO.h"
+#include "unity_cpp.h"
+
+#define PRODUCERS   4
+#define PER_THREAD  25000
+
+static XifoSharded<uint32_t> *sharded;
+
+static void producer(uint32_t id)
+{
+    for(uint32_t i = 1; i <= PER_THREAD; i++){
+        while(!sharded->try_write(id * PER_THREAD + i)){
+            std::this_thread::yield();
+        }
+    }
+}
+
+void testShardedDrainKeepsProducerOrder(void)
+{
+    std::thread p[PRODUCERS];
+    uint32_t last[PRODUCERS] = { 0 };
+    uint32_t buf[100];
+    uint32_t total = 0, wrong = 0;
+    uint64_t sum = 0, written = 0;
+    sharded = new XifoSharded<uint32_t>(3, 32);
+    for(uint32_t i = 0; i < PRODUCERS; i++){
+        p[i] = std::thread(producer, i);
+    }
+    while(total < PRODUCERS * PER_THREAD){
+        uint32_t n = sharded->drain(buf, 100);
+        if(n == 0){
+            std::this_thread::yield();
+        }
+        for(uint32_t i = 0; i < n; i++){
+            uint32_t id = (buf[i] - 1) / PER_THREAD;
+            /* One producer always uses the same shard */
+            if(buf[i] <= last[id]){
+                wrong++;
+            }
+            last[id] = buf[i];
+            sum += buf[i];
+        }
+        total += n;
+    }
+    for(uint32_t i = 0; i < PRODUCERS; i++){
+        p[i].join();
+        for(uint32_t j = 1; j <= PER_THREAD; j++){
+            written += i * PER_THREAD + j;
+        }
+    }
+    TEST_ASSERT_EQUAL(0u, wrong);
+    TEST_ASSERT_EQUAL(written, sum);
+    TEST_ASSERT_EQUAL(0u, sharded->used());
+    TEST_ASSERT_EQUAL(0u, sharded->drain(buf, 100));
+    delete sharded;
+}
+
+int main(void)
+{
+    RUN_TEST(testShardedDrainKeepsProducerOrder);
+    return UNITY_END();
+}
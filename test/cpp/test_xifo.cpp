@@ -0,0 +1,37 @@
+#include "xIFO.h"
+#include "unity_cpp.h"
+
+void testPlainFifoOrder(void)
+{
+    Xifo<int> x(4);
+    for(int i = 1; i <= 6; i++){
+        x.write(i);
+    }
+    TEST_ASSERT_EQUAL(1u, x.full());
+    TEST_ASSERT_EQUAL(3, x.pop_lr());
+    TEST_ASSERT_EQUAL(6, x.pop_mr());
+    TEST_ASSERT_EQUAL(2u, x.used());
+}
+
+void testMirrorWindowCrossesEnd(void)
+{
+    uint32_t size = xifo_mirror_granularity() / sizeof(int);
+    Xifo<int> x(size, XifoMirror());
+    const int *p;
+    uint32_t len;
+    TEST_ASSERT_TRUE(x.mirrored());
+    for(uint32_t i = 0; i < size + size / 2; i++){
+        x.write((int)i);
+    }
+    x.peek_contiguous(p, len);
+    TEST_ASSERT_EQUAL(size, len);
+    TEST_ASSERT_EQUAL((int)(size / 2), p[0]);
+    TEST_ASSERT_EQUAL((int)(size + size / 2 - 1), p[len - 1]);
+}
+
+int main(void)
+{
+    RUN_TEST(testPlainFifoOrder);
+    RUN_TEST(testMirrorWindowCrossesEnd);
+    return UNITY_END();
+}
@@ -0,0 +1,31 @@
+/**
+ * @file    unity_cpp.h
+ * @brief   Minimal Unity style asserts for the C++ tests
+ * @details Ceedling only builds C, the C++ classes are tested with plain
+ *          executables built by the Makefile in this directory.
+ */
+#ifndef UNITY_CPP_H_
+#define UNITY_CPP_H_
+
+#include <stdio.h>
+
+static int unity_failures = 0;
+
+#define TEST_ASSERT_TRUE(cond) do{ \
+        if(!(cond)){ \
+            printf("%s:%d: FAIL: %s\n", __FILE__, __LINE__, #cond); \
+            unity_failures++; \
+        } \
+    }while(0)
+#define TEST_ASSERT_FALSE(cond)         TEST_ASSERT_TRUE(!(cond))
+#define TEST_ASSERT_EQUAL(exp, act)     TEST_ASSERT_TRUE((exp) == (act))
+
+#define RUN_TEST(fn) do{ \
+        int before = unity_failures; \
+        fn(); \
+        printf("%s:%s:%s\n", __FILE__, #fn, (unity_failures == before) ? "PASS" : "FAIL"); \
+    }while(0)
+
+#define UNITY_END() (unity_failures != 0)
+
+#endif
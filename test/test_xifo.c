@@ -0,0 +1,124 @@
+#include "unity.h"
+#include "xifo.h"
+
+TEST_FILE("xifo.c")
+
+typedef struct {
+    uint32_t id;
+    float x, y;
+} point_t;
+
+xifo_t xifo;
+
+struct test {
+    uint32_t guard0;
+    point_t buffer[3];
+    uint32_t guard1;
+} testallocation;
+
+int testGuards(){
+    if(testallocation.guard0 != 0xAAAAAAAA) return 0;
+    if(testallocation.guard1 != 0xAAAAAAAA) return 0;
+    return 1;
+}
+
+void setUp(void)
+{
+    testallocation.guard0 = 0xAAAAAAAA;
+    testallocation.guard1 = 0xAAAAAAAA;
+    xifo_init(&xifo, 3, sizeof(point_t), testallocation.buffer);
+    TEST_ASSERT_EQUAL(xifo.size, 3);
+    TEST_ASSERT_EQUAL(xifo_get_esize(&xifo), 12);
+}
+
+void tearDown(void)
+{
+
+}
+
+void testStructsOverwriteOldest(void){
+    point_t p = { 0, 1.5f, 2.5f };
+    for(p.id = 1; p.id <= 4; p.id++){
+        xifo_write(&xifo, &p);
+    }
+    TEST_ASSERT_EQUAL(1, xifo_get_full(&xifo));
+    TEST_ASSERT_TRUE(xifo_read_lr(&xifo, 0, &p));
+    TEST_ASSERT_EQUAL(2, p.id);
+    TEST_ASSERT_TRUE(xifo_read_mr(&xifo, 0, &p));
+    TEST_ASSERT_EQUAL(4, p.id);
+    TEST_ASSERT_FALSE(xifo_read_lr(&xifo, 3, &p));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testPopBothEnds(void){
+    point_t p = { 0, 0.0f, 0.0f };
+    for(p.id = 1; p.id <= 3; p.id++){
+        xifo_write(&xifo, &p);
+    }
+    TEST_ASSERT_TRUE(xifo_pop_lr(&xifo, &p));
+    TEST_ASSERT_EQUAL(1, p.id);
+    TEST_ASSERT_TRUE(xifo_pop_mr(&xifo, &p));
+    TEST_ASSERT_EQUAL(3, p.id);
+    TEST_ASSERT_EQUAL(0, testallocation.buffer[2].id);
+    TEST_ASSERT_TRUE(xifo_pop_lr(&xifo, &p));
+    TEST_ASSERT_EQUAL(2, p.id);
+    TEST_ASSERT_FALSE(xifo_pop_lr(&xifo, &p));
+    TEST_ASSERT_EQUAL(0, xifo_get_used(&xifo));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testMergeTimestampOrder(void){
+    point_t pools[3][4], out[12];
+    xifo_t rings[3];
+    xifo_merge_node_t heap[3];
+    xifo_merge_t merge;
+    /* Timestamps per ring, crossing the 32 bit wrap */
+    uint32_t ts[3][4] = {
+        { 0xFFFFFFF0, 0xFFFFFFFA, 5, 30 },
+        { 0xFFFFFFF5, 2, 3, 40 },
+        { 0xFFFFFFF1, 10, 0, 0 },
+    };
+    point_t p = { 0, 0.0f, 0.0f };
+    uint32_t r, i;
+    for(r = 0; r < 3; r++){
+        xifo_init(&rings[r], 4, sizeof(point_t), pools[r]);
+        for(i = 0; i < (r == 2 ? 2 : 4); i++){
+            p.id = ts[r][i];
+            p.x = (float)r;
+            xifo_write(&rings[r], &p);
+        }
+    }
+    xifo_merge_init(&merge, rings, 3, heap, 0, 0);
+    TEST_ASSERT_EQUAL(10, xifo_merge_pop_n(&merge, out, 12));
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFF0, out[0].id);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFF1, out[1].id);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFF5, out[2].id);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFA, out[3].id);
+    TEST_ASSERT_EQUAL(2, out[4].id);
+    TEST_ASSERT_EQUAL(3, out[5].id);
+    TEST_ASSERT_EQUAL(5, out[6].id);
+    TEST_ASSERT_EQUAL(10, out[7].id);
+    TEST_ASSERT_EQUAL(30, out[8].id);
+    TEST_ASSERT_EQUAL(40, out[9].id);
+    TEST_ASSERT_EQUAL(0, xifo_merge_pop_n(&merge, out, 12));
+}
+
+void testMergeStrictStopsAtEmptyRing(void){
+    point_t pools[2][4], out[4];
+    xifo_t rings[2];
+    xifo_merge_node_t heap[2];
+    xifo_merge_t merge;
+    point_t p = { 0, 0.0f, 0.0f };
+    xifo_init(&rings[0], 4, sizeof(point_t), pools[0]);
+    xifo_init(&rings[1], 4, sizeof(point_t), pools[1]);
+    xifo_merge_init(&merge, rings, 2, heap, 0, 1);
+    p.id = 1; xifo_write(&rings[0], &p);
+    p.id = 4; xifo_write(&rings[0], &p);
+    /* Ring 1 may still receive older records */
+    TEST_ASSERT_EQUAL(0, xifo_merge_pop_n(&merge, out, 4));
+    p.id = 2; xifo_write(&rings[1], &p);
+    TEST_ASSERT_EQUAL(2, xifo_merge_pop_n(&merge, out, 4));
+    TEST_ASSERT_EQUAL(1, out[0].id);
+    TEST_ASSERT_EQUAL(2, out[1].id);
+    TEST_ASSERT_EQUAL(1, xifo_get_used(&rings[0]));
+}
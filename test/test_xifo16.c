@@ -0,0 +1,269 @@
+#include "unity.h"
+#include "xifo.h"
+#if xIFO_USE_ATOMIC == TRUE
+#include <pthread.h>
+#endif
+
+TEST_FILE("xifo16.c")
+TEST_FILE("xifo_linux.c")
+
+xifo16_t xifo;
+
+struct test {
+    uint32_t guard0;
+    xifo16_pool_t buffer[5];
+    uint32_t guard1;
+} testallocation;
+
+uint16_t testdata[10] = { 11, 22, 33, 44, 55, 66, 77, 88, 99, 100 };
+
+int testGuards(){
+    if(testallocation.guard0 != 0xAAAAAAAA) return 0;
+    if(testallocation.guard1 != 0xAAAAAAAA) return 0;
+    return 1;
+}
+
+void setUp(void)
+{
+    testallocation.guard0 = 0xAAAAAAAA;
+    testallocation.guard1 = 0xAAAAAAAA;
+    xifo16_init(&xifo, 5, testallocation.buffer);
+    xifo16_clear(&xifo);
+    TEST_ASSERT_EQUAL(xifo.size, 5);
+}
+
+void tearDown(void)
+{
+
+}
+
+void testOverwriteAndPopBothEnds(void){
+    int i;
+    for(i = 0; i < 7; i++){
+        xifo16_write(&xifo, testdata[i]);
+    }
+    TEST_ASSERT_EQUAL(1, xifo16_get_full(&xifo));
+    TEST_ASSERT_EQUAL(testdata[2], xifo16_read_lr(&xifo, 0));
+    TEST_ASSERT_EQUAL(testdata[6], xifo16_read_mr(&xifo, 0));
+    TEST_ASSERT_EQUAL(testdata[2], xifo16_pop_lr(&xifo));
+    TEST_ASSERT_EQUAL(testdata[6], xifo16_pop_mr(&xifo));
+    TEST_ASSERT_EQUAL(3, xifo16_get_used(&xifo));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+xifo16_spsc_t spsc;
+
+void testSpscWriteUntilFullAndPop(void){
+    uint16_t data;
+    int i;
+    xifo16_spsc_init(&spsc, 5, testallocation.buffer);
+    for(i = 0; i < 5; i++){
+        TEST_ASSERT_TRUE(xifo16_spsc_write(&spsc, testdata[i]));
+    }
+    TEST_ASSERT_FALSE(xifo16_spsc_write(&spsc, testdata[5]));
+    TEST_ASSERT_EQUAL(testdata[4], xifo16_spsc_read_lr(&spsc, 4));
+    TEST_ASSERT_TRUE(xifo16_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_EQUAL(testdata[0], data);
+    TEST_ASSERT_TRUE(xifo16_spsc_write(&spsc, testdata[5]));
+    for(i = 1; i <= 5; i++){
+        TEST_ASSERT_TRUE(xifo16_spsc_pop_lr(&spsc, &data));
+        TEST_ASSERT_EQUAL(testdata[i], data);
+    }
+    TEST_ASSERT_FALSE(xifo16_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testSpscReserveCommitAcrossWrap(void){
+    uint16_t *wp;
+    const uint16_t *rp;
+    uint16_t data;
+    xifo16_spsc_init(&spsc, 5, testallocation.buffer);
+    xifo16_spsc_write(&spsc, testdata[0]);
+    xifo16_spsc_write(&spsc, testdata[1]);
+    xifo16_spsc_write(&spsc, testdata[2]);
+    xifo16_spsc_pop_lr(&spsc, &data);
+    xifo16_spsc_pop_lr(&spsc, &data);
+    TEST_ASSERT_EQUAL(2, xifo16_spsc_reserve(&spsc, &wp, 4));
+    wp[0] = testdata[3];
+    wp[1] = testdata[4];
+    TEST_ASSERT_EQUAL(2, xifo16_spsc_reserve(&spsc, &wp, 2));
+    wp[0] = testdata[5];
+    wp[1] = testdata[6];
+    xifo16_spsc_commit(&spsc, 4);
+    TEST_ASSERT_EQUAL(3, xifo16_spsc_peek(&spsc, &rp, 5));
+    TEST_ASSERT_EQUAL(testdata[2], rp[0]);
+    TEST_ASSERT_EQUAL(2, xifo16_spsc_peek(&spsc, &rp, 5));
+    TEST_ASSERT_EQUAL(testdata[6], rp[1]);
+    xifo16_spsc_release(&spsc, 5);
+    TEST_ASSERT_EQUAL(0, xifo16_spsc_get_used(&spsc));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+xifo16_bc_t bc;
+xifo16_bc_reader_t logger;
+
+void testBroadcastLappedReaderAndSnapshot(void){
+    uint16_t data, history[3];
+    int i;
+    xifo16_bc_init(&bc, 5, testallocation.buffer);
+    xifo16_bc_reader_init(&bc, &logger);
+    for(i = 0; i < 10; i++){
+        xifo16_bc_write(&bc, testdata[i]);
+    }
+    TEST_ASSERT_TRUE(xifo16_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_EQUAL(testdata[6], data);
+    TEST_ASSERT_EQUAL(6, xifo16_bc_get_lost(&logger));
+    TEST_ASSERT_EQUAL(3, xifo16_bc_snapshot_mr(&bc, history, 3));
+    TEST_ASSERT_EQUAL(testdata[7], history[0]);
+    TEST_ASSERT_EQUAL(testdata[9], history[2]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testBulkWritePopAcrossWrap(void){
+    uint16_t block[5];
+    TEST_ASSERT_EQUAL(2, xifo16_write_n(&xifo, testdata, 3));
+    TEST_ASSERT_EQUAL(2, xifo16_pop_lr_n(&xifo, block, 2));
+    TEST_ASSERT_EQUAL(testdata[1], block[1]);
+    TEST_ASSERT_EQUAL(0, xifo16_write_n(&xifo, &testdata[3], 4));
+    TEST_ASSERT_EQUAL(4, xifo16_read_lr_n(&xifo, block, 1, 5));
+    TEST_ASSERT_EQUAL(testdata[3], block[0]);
+    TEST_ASSERT_EQUAL(testdata[6], block[3]);
+    TEST_ASSERT_EQUAL(5, xifo16_pop_lr_n(&xifo, block, 5));
+    TEST_ASSERT_EQUAL(testdata[2], block[0]);
+    TEST_ASSERT_EQUAL(0, testallocation.buffer[0]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testPeekContiguousAndConsume(void){
+    const uint16_t *p1, *p2;
+    uint32_t len1, len2;
+    xifo16_write_n(&xifo, testdata, 4);
+    xifo16_consume(&xifo, 2);
+    xifo16_write_n(&xifo, &testdata[4], 3);
+    xifo16_peek_segments(&xifo, &p1, &len1, &p2, &len2);
+    TEST_ASSERT_EQUAL(3, len1);
+    TEST_ASSERT_EQUAL(testdata[2], p1[0]);
+    TEST_ASSERT_EQUAL(2, len2);
+    TEST_ASSERT_EQUAL(testdata[6], p2[1]);
+    TEST_ASSERT_EQUAL(5, xifo16_consume(&xifo, 7));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+static void sumElements(uint16_t data, void *ctx){
+    *(uint32_t *)ctx += data;
+}
+
+void testForEachAndDrainAcrossWrap(void){
+    uint32_t sum = 0;
+    xifo16_write_n(&xifo, testdata, 7);
+    TEST_ASSERT_EQUAL(5, xifo16_for_each_lr(&xifo, sumElements, &sum));
+    TEST_ASSERT_EQUAL(33 + 44 + 55 + 66 + 77, sum);
+    sum = 0;
+    TEST_ASSERT_EQUAL(5, xifo16_drain_lr(&xifo, sumElements, &sum));
+    TEST_ASSERT_EQUAL(33 + 44 + 55 + 66 + 77, sum);
+    TEST_ASSERT_EQUAL(0, xifo16_get_used(&xifo));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testPowerOfTwoWraps(void){
+    xifo16_p2_t p2;
+    int i;
+    /* 5 rounds down to 4 */
+    xifo16_p2_init(&p2, 5, testallocation.buffer);
+    TEST_ASSERT_EQUAL(4, xifo16_p2_get_size(&p2));
+    for(i = 0; i < 6; i++){
+        xifo16_p2_write(&p2, testdata[i]);
+    }
+    TEST_ASSERT_EQUAL(1, xifo16_p2_get_full(&p2));
+    TEST_ASSERT_EQUAL(testdata[2], xifo16_p2_read_lr(&p2, 0));
+    TEST_ASSERT_EQUAL(testdata[5], xifo16_p2_pop_mr(&p2));
+    TEST_ASSERT_EQUAL(testdata[2], xifo16_p2_pop_lr(&p2));
+    TEST_ASSERT_EQUAL(2, xifo16_p2_get_used(&p2));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testCompactWraps(void){
+    xifo16_compact_t small;
+    int i;
+    xifo16_compact_init(&small, 5, testallocation.buffer);
+    for(i = 0; i < 7; i++){
+        xifo16_compact_write(&small, testdata[i]);
+    }
+    TEST_ASSERT_EQUAL(1, xifo16_compact_get_full(&small));
+    TEST_ASSERT_EQUAL(testdata[2], xifo16_compact_read_lr(&small, 0));
+    TEST_ASSERT_EQUAL(testdata[6], xifo16_compact_pop_mr(&small));
+    TEST_ASSERT_EQUAL(testdata[2], xifo16_compact_pop_lr(&small));
+    TEST_ASSERT_EQUAL(3, xifo16_compact_get_used(&small));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testExternalProducerIndexRegister(void){
+    xifo16_ext_t dma;
+    volatile uint32_t index = 0;
+    uint16_t block[5];
+    xifo16_ext_init(&dma, &xifo, &index, 0);
+    /* Simulated DMA writes 3 samples */
+    testallocation.buffer[0] = testdata[0];
+    testallocation.buffer[1] = testdata[1];
+    testallocation.buffer[2] = testdata[2];
+    index = 3;
+    TEST_ASSERT_EQUAL(3, xifo16_ext_sync(&dma));
+    TEST_ASSERT_EQUAL(testdata[0], xifo16_pop_lr(&xifo));
+    /* Wraps: 3 more */
+    testallocation.buffer[3] = testdata[3];
+    testallocation.buffer[4] = testdata[4];
+    testallocation.buffer[0] = testdata[5];
+    index = 1;
+    TEST_ASSERT_EQUAL(3, xifo16_ext_sync(&dma));
+    TEST_ASSERT_EQUAL(5, xifo16_pop_lr_n(&xifo, block, 5));
+    TEST_ASSERT_EQUAL(testdata[1], block[0]);
+    TEST_ASSERT_EQUAL(testdata[5], block[4]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+#if xIFO_USE_ATOMIC == TRUE
+#define THREAD_ELEMENTS     20000
+
+static xIFO_ATOMIC(uint32_t) thread_index;
+static xIFO_ATOMIC(uint32_t) thread_consumed;
+
+/* Plays the DMA: fills the pool and publishes the index */
+static void *producerThread(void *arg){
+    uint32_t i;
+    (void)arg;
+    for(i = 0; i < THREAD_ELEMENTS; i++){
+        /* Keep one slot free, a full lap would not be seen */
+        while(i - atomic_load_explicit(&thread_consumed, memory_order_acquire) >= 4){
+            xIFO_CPU_RELAX();
+        }
+        testallocation.buffer[i % 5] = (uint16_t)i;
+        atomic_store_explicit(&thread_index, (i + 1) % 5, memory_order_release);
+    }
+    return NULL;
+}
+
+void testExternalProducerThread(void){
+    xifo16_ext_t ext;
+    pthread_t producer;
+    uint32_t expect = 0;
+    uint32_t wrong = 0;
+    atomic_store(&thread_index, 0);
+    atomic_store(&thread_consumed, 0);
+    xifo16_ext_init(&ext, &xifo, (const volatile uint32_t *)&thread_index, 0);
+    TEST_ASSERT_EQUAL(0, pthread_create(&producer, NULL, producerThread, NULL));
+    while(expect < THREAD_ELEMENTS){
+        uint32_t n = xifo16_ext_sync(&ext);
+        while(n--){
+            if(xifo16_pop_lr(&xifo) != (uint16_t)expect){
+                wrong++;
+            }
+            expect++;
+        }
+        atomic_store_explicit(&thread_consumed, expect, memory_order_release);
+    }
+    pthread_join(producer, NULL);
+    TEST_ASSERT_EQUAL(0, wrong);
+    TEST_ASSERT_EQUAL(0, ext.lost);
+    TEST_ASSERT_TRUE(testGuards());
+}
+#endif
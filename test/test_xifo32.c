@@ -0,0 +1,163 @@
+#include "unity.h"
+#include "xifo.h"
+
+TEST_FILE("xifo32.c")
+TEST_FILE("xifo_linux.c")
+
+xifo32_pool_t pools[3][8];
+xifo32_t levels[3];
+xifo32_prio_t prio;
+
+void setUp(void)
+{
+    uint32_t i;
+    for(i = 0; i < 3; i++){
+        xifo32_init(&levels[i], 8, pools[i]);
+    }
+}
+
+void tearDown(void)
+{
+
+}
+
+void testPrioPopsHighestLevelFirst(void){
+    xifo32_prio_init(&prio, 3, levels, NULL);
+    TEST_ASSERT_EQUAL(3, xifo32_prio_get_level(&prio));
+    xifo32_prio_write(&prio, 2, 20);
+    xifo32_prio_write(&prio, 1, 10);
+    xifo32_prio_write(&prio, 2, 21);
+    xifo32_prio_write(&prio, 0, 1);
+    TEST_ASSERT_EQUAL(0, xifo32_prio_get_level(&prio));
+    TEST_ASSERT_EQUAL(1, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(10, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(20, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(21, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(3, xifo32_prio_get_level(&prio));
+    TEST_ASSERT_EQUAL(0, xifo32_prio_pop(&prio));
+}
+
+void testPrioInitPicksUpExistingData(void){
+    xifo32_write(&levels[1], 5);
+    xifo32_prio_init(&prio, 3, levels, NULL);
+    TEST_ASSERT_EQUAL(1, xifo32_prio_get_level(&prio));
+    TEST_ASSERT_EQUAL(5, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(0, xifo32_prio_write(&prio, 3, 1));
+}
+
+void testPrioQuotaLetsLowerLevelThrough(void){
+    const uint32_t quota[3] = { 2, 0, 0 };
+    uint32_t i;
+    xifo32_prio_init(&prio, 3, levels, quota);
+    for(i = 0; i < 5; i++){
+        xifo32_prio_write(&prio, 0, 100 + i);
+    }
+    xifo32_prio_write(&prio, 2, 200);
+    xifo32_prio_write(&prio, 2, 201);
+    TEST_ASSERT_EQUAL(100, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(101, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(200, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(102, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(103, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(201, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(104, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(3, xifo32_prio_get_level(&prio));
+}
+
+void testPowerOfTwoWrapsLikePlain(void){
+    xifo32_p2_t p2;
+    uint32_t i;
+    /* 6 rounds down to 4 */
+    xifo32_p2_init(&p2, 6, pools[0]);
+    xifo32_p2_clear(&p2);
+    TEST_ASSERT_EQUAL(4, xifo32_p2_get_size(&p2));
+    for(i = 1; i <= 6; i++){
+        xifo32_p2_write(&p2, i);
+    }
+    TEST_ASSERT_EQUAL(1, xifo32_p2_get_full(&p2));
+    TEST_ASSERT_EQUAL(0, xifo32_p2_get_free(&p2));
+    TEST_ASSERT_EQUAL(3, xifo32_p2_read_lr(&p2, 0));
+    TEST_ASSERT_EQUAL(6, xifo32_p2_read_mr(&p2, 0));
+    TEST_ASSERT_EQUAL(0, xifo32_p2_read_lr(&p2, 4));
+    TEST_ASSERT_EQUAL(6, xifo32_p2_pop_mr(&p2));
+    TEST_ASSERT_EQUAL(3, xifo32_p2_pop_lr(&p2));
+    xifo32_p2_write(&p2, 7);
+    TEST_ASSERT_EQUAL(4, xifo32_p2_pop_lr(&p2));
+    TEST_ASSERT_EQUAL(5, xifo32_p2_pop_lr(&p2));
+    TEST_ASSERT_EQUAL(7, xifo32_p2_pop_lr(&p2));
+    TEST_ASSERT_EQUAL(0, xifo32_p2_get_used(&p2));
+    TEST_ASSERT_EQUAL(0, xifo32_p2_pop_lr(&p2));
+}
+
+void testPowerOfTwoSizeZeroIsOne(void){
+    xifo32_p2_t p2;
+    pools[0][1] = 0xAAAAAAAA;
+    xifo32_p2_init(&p2, 0, pools[0]);
+    xifo32_p2_clear(&p2);
+    TEST_ASSERT_EQUAL(1, xifo32_p2_get_size(&p2));
+    xifo32_p2_write(&p2, 1);
+    xifo32_p2_write(&p2, 2);
+    TEST_ASSERT_EQUAL(1, xifo32_p2_get_used(&p2));
+    TEST_ASSERT_EQUAL(2, xifo32_p2_pop_lr(&p2));
+    /* Nothing written past the one element */
+    TEST_ASSERT_EQUAL(0xAAAAAAAA, pools[0][1]);
+}
+
+void testCompactMatchesPlain(void){
+    xifo32_compact_t small;
+    uint32_t i;
+    TEST_ASSERT_TRUE(sizeof(xifo32_compact_t) <= 16);
+    xifo32_init(&levels[1], 5, pools[1]);
+    xifo32_compact_init(&small, 5, pools[0]);
+    xifo32_compact_clear(&small);
+    for(i = 1; i <= 7; i++){
+        TEST_ASSERT_EQUAL(xifo32_write(&levels[1], i), xifo32_compact_write(&small, i));
+    }
+    TEST_ASSERT_EQUAL(1, xifo32_compact_get_full(&small));
+    TEST_ASSERT_EQUAL(5, xifo32_compact_get_size(&small));
+    TEST_ASSERT_EQUAL(3, xifo32_compact_read_lr(&small, 0));
+    TEST_ASSERT_EQUAL(7, xifo32_compact_read_mr(&small, 0));
+    TEST_ASSERT_EQUAL(xifo32_pop_mr(&levels[1]), xifo32_compact_pop_mr(&small));
+    TEST_ASSERT_EQUAL(xifo32_pop_lr(&levels[1]), xifo32_compact_pop_lr(&small));
+    xifo32_write(&levels[1], 8);
+    xifo32_compact_write(&small, 8);
+    for(i = 0; i < 5; i++){
+        TEST_ASSERT_EQUAL(pools[1][i], pools[0][i]);
+    }
+    TEST_ASSERT_EQUAL(xifo32_get_used(&levels[1]), xifo32_compact_get_used(&small));
+    TEST_ASSERT_EQUAL(xifo32_get_free(&levels[1]), xifo32_compact_get_free(&small));
+}
+
+void testPrioLevelPoppedDirectly(void){
+    xifo32_prio_init(&prio, 3, levels, NULL);
+    xifo32_prio_write(&prio, 0, 1);
+    xifo32_prio_write(&prio, 2, 20);
+    /* The level buffers belong to the application */
+    TEST_ASSERT_EQUAL(1, xifo32_pop_lr(&levels[0]));
+    TEST_ASSERT_EQUAL(2, xifo32_prio_get_level(&prio));
+    TEST_ASSERT_EQUAL(20, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(3, xifo32_prio_get_level(&prio));
+    xifo32_prio_write(&prio, 1, 10);
+    xifo32_prio_write(&prio, 2, 21);
+    TEST_ASSERT_EQUAL(10, xifo32_pop_lr(&levels[1]));
+    TEST_ASSERT_EQUAL(21, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(0, xifo32_prio_pop(&prio));
+}
+
+void testPrioLevelsClampedTo32(void){
+    xifo32_pool_t many_pools[40][2];
+    xifo32_t many[40];
+    uint32_t i;
+    for(i = 0; i < 40; i++){
+        xifo32_init(&many[i], 2, many_pools[i]);
+    }
+    xifo32_prio_init(&prio, 40, many, NULL);
+    TEST_ASSERT_EQUAL(32, prio.levels);
+    TEST_ASSERT_EQUAL(0, xifo32_prio_write(&prio, 35, 7));
+    TEST_ASSERT_EQUAL(0, many[35].count);
+    xifo32_prio_write(&prio, 31, 5);
+    xifo32_prio_write(&prio, 30, 4);
+    TEST_ASSERT_EQUAL(4, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(5, xifo32_prio_pop(&prio));
+    TEST_ASSERT_EQUAL(0, prio.nonempty);
+}
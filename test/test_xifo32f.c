@@ -1,7 +1,11 @@
 #include "unity.h"
 #include "xifo.h"
+#if xIFO_USE_LINUX == TRUE
+#include <unistd.h>
+#endif
 
 TEST_FILE("xifo32f.c")
+TEST_FILE("xifo_linux.c")
 
 xifo32f_t xifo;
 
@@ -200,4 +204,256 @@ void testGetFree(){
     TEST_ASSERT_FALSE(xifo32f_get_free(&xifo));
     xifo32f_pop_lr(&xifo);
     TEST_ASSERT_TRUE(xifo32f_get_free(&xifo));
-}
\ No newline at end of file
+}
+xifo32f_spsc_t spsc;
+
+void testSpscWriteUntilFullAndPop(void){
+    float data;
+    xifo32f_spsc_init(&spsc, 5, testallocation.buffer);
+    TEST_ASSERT_TRUE(xifo32f_spsc_write(&spsc, testdata[0]));
+    TEST_ASSERT_TRUE(xifo32f_spsc_write(&spsc, testdata[1]));
+    TEST_ASSERT_TRUE(xifo32f_spsc_write(&spsc, testdata[2]));
+    TEST_ASSERT_TRUE(xifo32f_spsc_write(&spsc, testdata[3]));
+    TEST_ASSERT_TRUE(xifo32f_spsc_write(&spsc, testdata[4]));
+    TEST_ASSERT_FALSE(xifo32f_spsc_write(&spsc, testdata[5]));
+    TEST_ASSERT_TRUE(xifo32f_spsc_get_full(&spsc));
+    TEST_ASSERT_EQUAL(xifo32f_spsc_read_lr(&spsc, 4), testdata[4]);
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_EQUAL(data, testdata[0]);
+    TEST_ASSERT_TRUE(xifo32f_spsc_write(&spsc, testdata[5]));
+    TEST_ASSERT_EQUAL(xifo32f_spsc_get_used(&spsc), 5);
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_EQUAL(data, testdata[1]);
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_EQUAL(data, testdata[5]);
+    TEST_ASSERT_FALSE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_EQUAL(xifo32f_spsc_get_free(&spsc), 5);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+xifo32f_bc_t bc;
+xifo32f_bc_reader_t logger, uplink;
+
+void testBroadcastReadersAreIndependent(void){
+    float data;
+    xifo32f_bc_init(&bc, 5, testallocation.buffer);
+    xifo32f_bc_reader_init(&bc, &logger);
+    xifo32f_bc_write(&bc, testdata[0]);
+    xifo32f_bc_reader_init(&bc, &uplink);
+    xifo32f_bc_write(&bc, testdata[1]);
+    TEST_ASSERT_EQUAL(xifo32f_bc_get_used(&bc, &logger), 2);
+    TEST_ASSERT_EQUAL(xifo32f_bc_get_used(&bc, &uplink), 1);
+    TEST_ASSERT_TRUE(xifo32f_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_EQUAL(data, testdata[0]);
+    TEST_ASSERT_TRUE(xifo32f_bc_read_lr(&bc, &uplink, &data));
+    TEST_ASSERT_EQUAL(data, testdata[1]);
+    TEST_ASSERT_TRUE(xifo32f_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_EQUAL(data, testdata[1]);
+    TEST_ASSERT_FALSE(xifo32f_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_FALSE(xifo32f_bc_read_lr(&bc, &uplink, &data));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testBroadcastLappedReaderCountsLost(void){
+    float data;
+    int i;
+    xifo32f_bc_init(&bc, 5, testallocation.buffer);
+    xifo32f_bc_reader_init(&bc, &logger);
+    for(i = 0; i < 10; i++){
+        xifo32f_bc_write(&bc, testdata[i]);
+    }
+    TEST_ASSERT_EQUAL(xifo32f_bc_get_used(&bc, &logger), 4);
+    TEST_ASSERT_TRUE(xifo32f_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_EQUAL(data, testdata[6]);
+    TEST_ASSERT_EQUAL(xifo32f_bc_get_lost(&logger), 6);
+    TEST_ASSERT_TRUE(xifo32f_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_TRUE(xifo32f_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_TRUE(xifo32f_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_EQUAL(data, testdata[9]);
+    TEST_ASSERT_FALSE(xifo32f_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+#if xIFO_USE_LINUX == TRUE
+void testSpscWaitTimesOut(void){
+    float data;
+    uint32_t start;
+    xifo32f_spsc_init(&spsc, 1, testallocation.buffer);
+    start = xifo_time_ms();
+    TEST_ASSERT_FALSE(xifo32f_spsc_pop_lr_wait(&spsc, &data, 20));
+    TEST_ASSERT_TRUE((xifo_time_ms() - start) >= 20);
+    TEST_ASSERT_TRUE(xifo32f_spsc_write_wait(&spsc, testdata[0], 20));
+    TEST_ASSERT_FALSE(xifo32f_spsc_write_wait(&spsc, testdata[1], 0));
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr_wait(&spsc, &data, xIFO_WAIT_FOREVER));
+    TEST_ASSERT_EQUAL(data, testdata[0]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testSpscEventfdCoalescesBurst(void){
+    float data;
+    uint64_t count = 0;
+    int rfd = xifo_eventfd_open();
+    int wfd = xifo_eventfd_open();
+    xifo32f_spsc_init(&spsc, 5, testallocation.buffer);
+    xifo32f_spsc_set_eventfd(&spsc, rfd, wfd);
+    xifo32f_spsc_write(&spsc, testdata[0]);
+    xifo32f_spsc_write(&spsc, testdata[1]);
+    xifo32f_spsc_write(&spsc, testdata[2]);
+    TEST_ASSERT_EQUAL(read(rfd, &count, sizeof(count)), sizeof(count));
+    TEST_ASSERT_EQUAL(count, 1);
+    xifo32f_spsc_write(&spsc, testdata[3]);
+    xifo32f_spsc_write(&spsc, testdata[4]);
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_TRUE(xifo32f_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_EQUAL(read(wfd, &count, sizeof(count)), sizeof(count));
+    TEST_ASSERT_EQUAL(count, 1);
+    TEST_ASSERT_TRUE(read(rfd, &count, sizeof(count)) < 0);
+    close(rfd);
+    close(wfd);
+}
+#endif
+
+void testBroadcastSnapshotMostRecent(void){
+    float history[5];
+    int i;
+    xifo32f_bc_init(&bc, 5, testallocation.buffer);
+    xifo32f_bc_write(&bc, testdata[0]);
+    xifo32f_bc_write(&bc, testdata[1]);
+    TEST_ASSERT_EQUAL(xifo32f_bc_snapshot_mr(&bc, history, 3), 2);
+    TEST_ASSERT_EQUAL(history[0], testdata[0]);
+    TEST_ASSERT_EQUAL(history[1], testdata[1]);
+    for(i = 2; i < 10; i++){
+        xifo32f_bc_write(&bc, testdata[i]);
+    }
+    TEST_ASSERT_EQUAL(xifo32f_bc_snapshot_mr(&bc, history, 3), 3);
+    TEST_ASSERT_EQUAL(history[0], testdata[7]);
+    TEST_ASSERT_EQUAL(history[1], testdata[8]);
+    TEST_ASSERT_EQUAL(history[2], testdata[9]);
+    TEST_ASSERT_EQUAL(xifo32f_bc_snapshot_mr(&bc, history, 5), 4);
+    TEST_ASSERT_EQUAL(history[0], testdata[6]);
+    TEST_ASSERT_EQUAL(history[3], testdata[9]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testSpscReserveCommitAcrossWrap(void){
+    float *wp;
+    const float *rp;
+    float data;
+    xifo32f_spsc_init(&spsc, 5, testallocation.buffer);
+    xifo32f_spsc_write(&spsc, testdata[0]);
+    xifo32f_spsc_write(&spsc, testdata[1]);
+    xifo32f_spsc_write(&spsc, testdata[2]);
+    xifo32f_spsc_pop_lr(&spsc, &data);
+    xifo32f_spsc_pop_lr(&spsc, &data);
+    /* Three free slots at the end, two at the start */
+    TEST_ASSERT_EQUAL(xifo32f_spsc_reserve(&spsc, &wp, 4), 2);
+    wp[0] = testdata[3];
+    wp[1] = testdata[4];
+    TEST_ASSERT_EQUAL(xifo32f_spsc_reserve(&spsc, &wp, 2), 2);
+    wp[0] = testdata[5];
+    wp[1] = testdata[6];
+    TEST_ASSERT_EQUAL(xifo32f_spsc_get_used(&spsc), 1);
+    xifo32f_spsc_commit(&spsc, 4);
+    TEST_ASSERT_EQUAL(xifo32f_spsc_get_used(&spsc), 5);
+    TEST_ASSERT_EQUAL(xifo32f_spsc_peek(&spsc, &rp, 5), 3);
+    TEST_ASSERT_EQUAL(rp[0], testdata[2]);
+    TEST_ASSERT_EQUAL(rp[2], testdata[4]);
+    TEST_ASSERT_EQUAL(xifo32f_spsc_peek(&spsc, &rp, 5), 2);
+    TEST_ASSERT_EQUAL(rp[1], testdata[6]);
+    xifo32f_spsc_release(&spsc, 5);
+    TEST_ASSERT_EQUAL(xifo32f_spsc_get_used(&spsc), 0);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testBulkWritePopAcrossWrap(void){
+    float block[5];
+    TEST_ASSERT_EQUAL(xifo32f_write_n(&xifo, testdata, 3), 2);
+    TEST_ASSERT_EQUAL(xifo32f_pop_lr_n(&xifo, block, 2), 2);
+    TEST_ASSERT_EQUAL(block[1], testdata[1]);
+    /* Wraps: two elements at the end, two at the start */
+    TEST_ASSERT_EQUAL(xifo32f_write_n(&xifo, &testdata[3], 4), 0);
+    TEST_ASSERT_EQUAL(xifo32f_read_mr(&xifo, 0), testdata[6]);
+    TEST_ASSERT_EQUAL(xifo32f_read_lr_n(&xifo, block, 1, 5), 4);
+    TEST_ASSERT_EQUAL(block[0], testdata[3]);
+    TEST_ASSERT_EQUAL(block[3], testdata[6]);
+    TEST_ASSERT_EQUAL(xifo32f_pop_lr_n(&xifo, block, 5), 5);
+    TEST_ASSERT_EQUAL(block[0], testdata[2]);
+    TEST_ASSERT_EQUAL(block[4], testdata[6]);
+    TEST_ASSERT_EQUAL(xifo32f_get_used(&xifo), 0);
+    TEST_ASSERT_EQUAL(0, testallocation.buffer[0]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testBulkWriteLargerThanBuffer(void){
+    TEST_ASSERT_EQUAL(xifo32f_write_n(&xifo, testdata, 8), 0);
+    TEST_ASSERT_EQUAL(xifo32f_read_lr(&xifo, 0), testdata[3]);
+    TEST_ASSERT_EQUAL(xifo32f_read_mr(&xifo, 0), testdata[7]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testPeekContiguousAndConsume(void){
+    const float *p1, *p2;
+    uint32_t len1, len2;
+    xifo32f_peek_contiguous(&xifo, &p1, &len1);
+    TEST_ASSERT_EQUAL(0, len1);
+    xifo32f_write_n(&xifo, testdata, 4);
+    xifo32f_consume(&xifo, 2);
+    xifo32f_write_n(&xifo, &testdata[4], 3);
+    /* testdata[2..4] at the end of the pool, [5..6] at the start */
+    xifo32f_peek_contiguous(&xifo, &p1, &len1);
+    TEST_ASSERT_EQUAL(3, len1);
+    TEST_ASSERT_EQUAL(p1[0], testdata[2]);
+    xifo32f_peek_segments(&xifo, &p1, &len1, &p2, &len2);
+    TEST_ASSERT_EQUAL(2, len2);
+    TEST_ASSERT_EQUAL(p2[1], testdata[6]);
+    TEST_ASSERT_EQUAL(xifo32f_consume(&xifo, len1), 3);
+    TEST_ASSERT_EQUAL(xifo32f_pop_lr(&xifo), testdata[5]);
+    TEST_ASSERT_EQUAL(xifo32f_consume(&xifo, 5), 1);
+    TEST_ASSERT_EQUAL(xifo32f_get_used(&xifo), 0);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+static void sumElements(float data, void *ctx){
+    *(float *)ctx += data;
+}
+
+void testForEachAndDrainAcrossWrap(void){
+    float sum = 0.0f;
+    xifo32f_write_n(&xifo, testdata, 7);
+    TEST_ASSERT_EQUAL(5, xifo32f_for_each_lr(&xifo, sumElements, &sum));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 27.5f, sum);
+    TEST_ASSERT_EQUAL(5, xifo32f_get_used(&xifo));
+    sum = 0.0f;
+    TEST_ASSERT_EQUAL(5, xifo32f_drain_lr(&xifo, sumElements, &sum));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 27.5f, sum);
+    TEST_ASSERT_EQUAL(0, xifo32f_get_used(&xifo));
+    TEST_ASSERT_EQUAL(0, testallocation.buffer[0]);
+    TEST_ASSERT_EQUAL(0, xifo32f_drain_lr(&xifo, sumElements, &sum));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+#if xIFO_USE_LINUX == TRUE
+void testMirrorPoolWindowCrossesEnd(void){
+    xifo32f_t mirror;
+    const float *ptr;
+    uint32_t len, i;
+    uint32_t bytes = xifo_mirror_granularity();
+    uint32_t size = bytes / sizeof(float);
+    float *pool = xifo_mirror_alloc(bytes);
+    TEST_ASSERT_NULL(xifo_mirror_alloc(bytes + 1));
+    TEST_ASSERT_NOT_NULL(pool);
+    xifo32f_init(&mirror, size, pool);
+    for(i = 0; i < size + 3; i++){
+        xifo32f_write(&mirror, (float)i);
+    }
+    xifo32f_peek_contiguous(&mirror, &ptr, &len);
+    TEST_ASSERT_EQUAL(size - 3, len);
+    /* The second view continues past the end of the pool */
+    TEST_ASSERT_EQUAL(ptr[len], (float)size);
+    TEST_ASSERT_EQUAL(ptr[size - 1], (float)(size + 2));
+    xifo_mirror_free(pool, bytes);
+}
+#endif
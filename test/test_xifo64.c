@@ -0,0 +1,195 @@
+#include "unity.h"
+#include "xifo.h"
+
+TEST_FILE("xifo64.c")
+TEST_FILE("xifo_linux.c")
+
+xifo64_t xifo;
+
+struct test {
+    uint32_t guard0;
+    xifo64_pool_t buffer[5];
+    uint32_t guard1;
+} testallocation;
+
+uint64_t testdata[10] = { 11, 22, 33, 44, 55, 66, 77, 88, 99, 100 };
+
+int testGuards(){
+    if(testallocation.guard0 != 0xAAAAAAAA) return 0;
+    if(testallocation.guard1 != 0xAAAAAAAA) return 0;
+    return 1;
+}
+
+void setUp(void)
+{
+    testallocation.guard0 = 0xAAAAAAAA;
+    testallocation.guard1 = 0xAAAAAAAA;
+    xifo64_init(&xifo, 5, testallocation.buffer);
+    xifo64_clear(&xifo);
+    TEST_ASSERT_EQUAL(xifo.size, 5);
+}
+
+void tearDown(void)
+{
+
+}
+
+void testOverwriteAndPopBothEnds(void){
+    int i;
+    for(i = 0; i < 7; i++){
+        xifo64_write(&xifo, testdata[i]);
+    }
+    TEST_ASSERT_EQUAL(1, xifo64_get_full(&xifo));
+    TEST_ASSERT_EQUAL(testdata[2], xifo64_read_lr(&xifo, 0));
+    TEST_ASSERT_EQUAL(testdata[6], xifo64_read_mr(&xifo, 0));
+    TEST_ASSERT_EQUAL(testdata[2], xifo64_pop_lr(&xifo));
+    TEST_ASSERT_EQUAL(testdata[6], xifo64_pop_mr(&xifo));
+    TEST_ASSERT_EQUAL(3, xifo64_get_used(&xifo));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+xifo64_spsc_t spsc;
+
+void testSpscWriteUntilFullAndPop(void){
+    uint64_t data;
+    int i;
+    xifo64_spsc_init(&spsc, 5, testallocation.buffer);
+    for(i = 0; i < 5; i++){
+        TEST_ASSERT_TRUE(xifo64_spsc_write(&spsc, testdata[i]));
+    }
+    TEST_ASSERT_FALSE(xifo64_spsc_write(&spsc, testdata[5]));
+    TEST_ASSERT_EQUAL(testdata[4], xifo64_spsc_read_lr(&spsc, 4));
+    TEST_ASSERT_TRUE(xifo64_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_EQUAL(testdata[0], data);
+    TEST_ASSERT_TRUE(xifo64_spsc_write(&spsc, testdata[5]));
+    for(i = 1; i <= 5; i++){
+        TEST_ASSERT_TRUE(xifo64_spsc_pop_lr(&spsc, &data));
+        TEST_ASSERT_EQUAL(testdata[i], data);
+    }
+    TEST_ASSERT_FALSE(xifo64_spsc_pop_lr(&spsc, &data));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testSpscReserveCommitAcrossWrap(void){
+    uint64_t *wp;
+    const uint64_t *rp;
+    uint64_t data;
+    xifo64_spsc_init(&spsc, 5, testallocation.buffer);
+    xifo64_spsc_write(&spsc, testdata[0]);
+    xifo64_spsc_write(&spsc, testdata[1]);
+    xifo64_spsc_write(&spsc, testdata[2]);
+    xifo64_spsc_pop_lr(&spsc, &data);
+    xifo64_spsc_pop_lr(&spsc, &data);
+    TEST_ASSERT_EQUAL(2, xifo64_spsc_reserve(&spsc, &wp, 4));
+    wp[0] = testdata[3];
+    wp[1] = testdata[4];
+    TEST_ASSERT_EQUAL(2, xifo64_spsc_reserve(&spsc, &wp, 2));
+    wp[0] = testdata[5];
+    wp[1] = testdata[6];
+    xifo64_spsc_commit(&spsc, 4);
+    TEST_ASSERT_EQUAL(3, xifo64_spsc_peek(&spsc, &rp, 5));
+    TEST_ASSERT_EQUAL(testdata[2], rp[0]);
+    TEST_ASSERT_EQUAL(2, xifo64_spsc_peek(&spsc, &rp, 5));
+    TEST_ASSERT_EQUAL(testdata[6], rp[1]);
+    xifo64_spsc_release(&spsc, 5);
+    TEST_ASSERT_EQUAL(0, xifo64_spsc_get_used(&spsc));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+xifo64_bc_t bc;
+xifo64_bc_reader_t logger;
+
+void testBroadcastLappedReaderAndSnapshot(void){
+    uint64_t data, history[3];
+    int i;
+    xifo64_bc_init(&bc, 5, testallocation.buffer);
+    xifo64_bc_reader_init(&bc, &logger);
+    for(i = 0; i < 10; i++){
+        xifo64_bc_write(&bc, testdata[i]);
+    }
+    TEST_ASSERT_TRUE(xifo64_bc_read_lr(&bc, &logger, &data));
+    TEST_ASSERT_EQUAL(testdata[6], data);
+    TEST_ASSERT_EQUAL(6, xifo64_bc_get_lost(&logger));
+    TEST_ASSERT_EQUAL(3, xifo64_bc_snapshot_mr(&bc, history, 3));
+    TEST_ASSERT_EQUAL(testdata[7], history[0]);
+    TEST_ASSERT_EQUAL(testdata[9], history[2]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testBulkWritePopAcrossWrap(void){
+    uint64_t block[5];
+    TEST_ASSERT_EQUAL(2, xifo64_write_n(&xifo, testdata, 3));
+    TEST_ASSERT_EQUAL(2, xifo64_pop_lr_n(&xifo, block, 2));
+    TEST_ASSERT_EQUAL(testdata[1], block[1]);
+    TEST_ASSERT_EQUAL(0, xifo64_write_n(&xifo, &testdata[3], 4));
+    TEST_ASSERT_EQUAL(4, xifo64_read_lr_n(&xifo, block, 1, 5));
+    TEST_ASSERT_EQUAL(testdata[3], block[0]);
+    TEST_ASSERT_EQUAL(testdata[6], block[3]);
+    TEST_ASSERT_EQUAL(5, xifo64_pop_lr_n(&xifo, block, 5));
+    TEST_ASSERT_EQUAL(testdata[2], block[0]);
+    TEST_ASSERT_EQUAL(0, testallocation.buffer[0]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testPeekContiguousAndConsume(void){
+    const uint64_t *p1, *p2;
+    uint32_t len1, len2;
+    xifo64_write_n(&xifo, testdata, 4);
+    xifo64_consume(&xifo, 2);
+    xifo64_write_n(&xifo, &testdata[4], 3);
+    xifo64_peek_segments(&xifo, &p1, &len1, &p2, &len2);
+    TEST_ASSERT_EQUAL(3, len1);
+    TEST_ASSERT_EQUAL(testdata[2], p1[0]);
+    TEST_ASSERT_EQUAL(2, len2);
+    TEST_ASSERT_EQUAL(testdata[6], p2[1]);
+    TEST_ASSERT_EQUAL(5, xifo64_consume(&xifo, 7));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+static void sumElements(uint64_t data, void *ctx){
+    *(uint64_t *)ctx += data;
+}
+
+void testForEachAndDrainAcrossWrap(void){
+    uint64_t sum = 0;
+    xifo64_write_n(&xifo, testdata, 7);
+    TEST_ASSERT_EQUAL(5, xifo64_for_each_lr(&xifo, sumElements, &sum));
+    TEST_ASSERT_EQUAL(33 + 44 + 55 + 66 + 77, sum);
+    sum = 0;
+    TEST_ASSERT_EQUAL(5, xifo64_drain_lr(&xifo, sumElements, &sum));
+    TEST_ASSERT_EQUAL(33 + 44 + 55 + 66 + 77, sum);
+    TEST_ASSERT_EQUAL(0, xifo64_get_used(&xifo));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testPowerOfTwoWraps(void){
+    xifo64_p2_t p2;
+    int i;
+    /* 5 rounds down to 4 */
+    xifo64_p2_init(&p2, 5, testallocation.buffer);
+    TEST_ASSERT_EQUAL(4, xifo64_p2_get_size(&p2));
+    for(i = 0; i < 6; i++){
+        xifo64_p2_write(&p2, testdata[i]);
+    }
+    TEST_ASSERT_EQUAL(1, xifo64_p2_get_full(&p2));
+    TEST_ASSERT_EQUAL(testdata[2], xifo64_p2_read_lr(&p2, 0));
+    TEST_ASSERT_EQUAL(testdata[5], xifo64_p2_pop_mr(&p2));
+    TEST_ASSERT_EQUAL(testdata[2], xifo64_p2_pop_lr(&p2));
+    TEST_ASSERT_EQUAL(2, xifo64_p2_get_used(&p2));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testCompactWraps(void){
+    xifo64_compact_t small;
+    int i;
+    xifo64_compact_init(&small, 5, testallocation.buffer);
+    for(i = 0; i < 7; i++){
+        xifo64_compact_write(&small, testdata[i]);
+    }
+    TEST_ASSERT_EQUAL(1, xifo64_compact_get_full(&small));
+    TEST_ASSERT_EQUAL(testdata[2], xifo64_compact_read_lr(&small, 0));
+    TEST_ASSERT_EQUAL(testdata[6], xifo64_compact_pop_mr(&small));
+    TEST_ASSERT_EQUAL(testdata[2], xifo64_compact_pop_lr(&small));
+    TEST_ASSERT_EQUAL(3, xifo64_compact_get_used(&small));
+    TEST_ASSERT_TRUE(testGuards());
+}
@@ -0,0 +1,181 @@
+#include "unity.h"
+#include <string.h>
+#include "xifo.h"
+#if xIFO_USE_LINUX == TRUE
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+TEST_FILE("xifo8.c")
+TEST_FILE("xifo_linux.c")
+
+xifo8_t xifo;
+
+struct test {
+    uint32_t guard0;
+    xifo8_pool_t buffer[8];
+    uint32_t guard1;
+} testallocation;
+
+int testGuards(){
+    if(testallocation.guard0 != 0xAAAAAAAA) return 0;
+    if(testallocation.guard1 != 0xAAAAAAAA) return 0;
+    return 1;
+}
+
+void setUp(void)
+{
+    testallocation.guard0 = 0xAAAAAAAA;
+    testallocation.guard1 = 0xAAAAAAAA;
+    xifo8_init(&xifo, 8, testallocation.buffer);
+    TEST_ASSERT_EQUAL(xifo.size, 8);
+}
+
+void tearDown(void)
+{
+
+}
+
+void testBipWrapsEarlyInsteadOfSplitting(void){
+    xifo8_bip_t bip;
+    uint8_t *w;
+    const uint8_t *r;
+    uint32_t len;
+    xifo8_bip_init(&bip, 8, testallocation.buffer);
+    w = xifo8_bip_reserve(&bip, 5);
+    TEST_ASSERT_EQUAL_PTR(&testallocation.buffer[0], w);
+    memcpy(w, "hello", 5);
+    xifo8_bip_commit(&bip, 5);
+    r = xifo8_bip_peek(&bip, &len);
+    TEST_ASSERT_EQUAL(5, len);
+    xifo8_bip_release(&bip, 4);
+    /* Three bytes left at the end, four free at the start */
+    TEST_ASSERT_NULL(xifo8_bip_reserve(&bip, 5));
+    w = xifo8_bip_reserve(&bip, 4);
+    TEST_ASSERT_EQUAL_PTR(&testallocation.buffer[0], w);
+    memcpy(w, "abcd", 4);
+    xifo8_bip_commit(&bip, 4);
+    TEST_ASSERT_EQUAL(5, xifo8_bip_get_used(&bip));
+    r = xifo8_bip_peek(&bip, &len);
+    TEST_ASSERT_EQUAL(1, len);
+    TEST_ASSERT_EQUAL('o', r[0]);
+    xifo8_bip_release(&bip, 1);
+    r = xifo8_bip_peek(&bip, &len);
+    TEST_ASSERT_EQUAL(4, len);
+    TEST_ASSERT_EQUAL_STRING_LEN("abcd", (const char *)r, 4);
+    xifo8_bip_release(&bip, 4);
+    TEST_ASSERT_EQUAL(0, xifo8_bip_get_used(&bip));
+    TEST_ASSERT_NOT_NULL(xifo8_bip_reserve(&bip, 8));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+static void countBytes(const uint8_t *msg, uint32_t len, void *arg){
+    (void)msg;
+    *(uint32_t *)arg += len;
+}
+
+void testBipCommitAfterReaderDrained(void){
+    xifo8_bip_t bip;
+    uint8_t *w;
+    const uint8_t *r;
+    uint32_t len;
+    xifo8_bip_init(&bip, 8, testallocation.buffer);
+    w = xifo8_bip_reserve(&bip, 6);
+    memcpy(w, "abcdef", 6);
+    xifo8_bip_commit(&bip, 6);
+    xifo8_bip_release(&bip, 4);
+    /* No room at the end, wraps early to offset 0 */
+    w = xifo8_bip_reserve(&bip, 3);
+    TEST_ASSERT_EQUAL_PTR(&testallocation.buffer[0], w);
+    memcpy(w, "xyz", 3);
+    /* Reader drains region A before the commit */
+    r = xifo8_bip_peek(&bip, &len);
+    TEST_ASSERT_EQUAL(2, len);
+    xifo8_bip_release(&bip, len);
+    xifo8_bip_commit(&bip, 3);
+    TEST_ASSERT_EQUAL(3, xifo8_bip_get_used(&bip));
+    r = xifo8_bip_peek(&bip, &len);
+    TEST_ASSERT_EQUAL(3, len);
+    TEST_ASSERT_EQUAL_STRING_LEN("xyz", (const char *)r, 3);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testMessagesStayContiguous(void){
+    xifo8_msg_t msgs;
+    const uint8_t *m;
+    uint32_t len, bytes = 0;
+    xifo8_msg_init(&msgs, 8, testallocation.buffer);
+    TEST_ASSERT_NULL(xifo8_front_msg(&msgs, &len));
+    TEST_ASSERT_TRUE(xifo8_push_msg(&msgs, "abc", 3));
+    TEST_ASSERT_TRUE(xifo8_push_msg(&msgs, "", 0));
+    TEST_ASSERT_FALSE(xifo8_push_msg(&msgs, "defg", 4));
+    TEST_ASSERT_FALSE(xifo8_push_msg(&msgs, "too long", 8));
+    m = xifo8_front_msg(&msgs, &len);
+    TEST_ASSERT_EQUAL(3, len);
+    TEST_ASSERT_EQUAL_STRING_LEN("abc", (const char *)m, 3);
+    TEST_ASSERT_TRUE(xifo8_pop_msg(&msgs));
+    /* Wraps to the start of the pool as one block */
+    TEST_ASSERT_TRUE(xifo8_push_msg(&msgs, "xyz", 3));
+    TEST_ASSERT_EQUAL(2, xifo8_for_each_msg(&msgs, countBytes, &bytes));
+    TEST_ASSERT_EQUAL(3, bytes);
+    m = xifo8_front_msg(&msgs, &len);
+    TEST_ASSERT_EQUAL(0, len);
+    TEST_ASSERT_TRUE(xifo8_pop_msg(&msgs));
+    m = xifo8_front_msg(&msgs, &len);
+    TEST_ASSERT_EQUAL(3, len);
+    TEST_ASSERT_EQUAL_PTR(&testallocation.buffer[1], m);
+    TEST_ASSERT_TRUE(xifo8_pop_msg(&msgs));
+    TEST_ASSERT_FALSE(xifo8_pop_msg(&msgs));
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+void testExternalProducerRemainingCount(void){
+    xifo8_ext_t dma;
+    volatile uint32_t ndtr = 8;
+    uint8_t block[8];
+    xifo8_ext_init(&dma, &xifo, &ndtr, 1);
+    TEST_ASSERT_EQUAL(0, xifo8_ext_sync(&dma));
+    /* Simulated DMA writes 6 bytes */
+    memcpy(testallocation.buffer, "abcdef", 6);
+    ndtr = 2;
+    TEST_ASSERT_EQUAL(6, xifo8_ext_sync(&dma));
+    TEST_ASSERT_EQUAL('a', xifo8_pop_lr(&xifo));
+    TEST_ASSERT_EQUAL('f', xifo8_read_mr(&xifo, 0));
+    /* Wraps and reloads: 4 more bytes */
+    memcpy(&testallocation.buffer[6], "gh", 2);
+    memcpy(testallocation.buffer, "ij", 2);
+    ndtr = 6;
+    TEST_ASSERT_EQUAL(4, xifo8_ext_sync(&dma));
+    TEST_ASSERT_EQUAL(8, xifo8_get_used(&xifo));
+    TEST_ASSERT_EQUAL(1, dma.lost);
+    TEST_ASSERT_EQUAL(8, xifo8_pop_lr_n(&xifo, block, 8));
+    TEST_ASSERT_EQUAL_STRING_LEN("cdefghij", (const char *)block, 8);
+    TEST_ASSERT_TRUE(testGuards());
+}
+
+#if xIFO_USE_LINUX == TRUE
+void testFillAndDrainFdAcrossWrap(void){
+    int in[2], out[2];
+    char text[16] = { 0 };
+    TEST_ASSERT_EQUAL(0, pipe(in));
+    TEST_ASSERT_EQUAL(0, pipe(out));
+    TEST_ASSERT_EQUAL(6, write(in[1], "abcdef", 6));
+    TEST_ASSERT_EQUAL(6, xifo8_fill_from_fd(&xifo, in[0]));
+    TEST_ASSERT_EQUAL(4, xifo8_consume(&xifo, 4));
+    /* Free space wraps: two at the end, four at the start */
+    TEST_ASSERT_EQUAL(7, write(in[1], "0123456", 7));
+    TEST_ASSERT_EQUAL(6, xifo8_fill_from_fd(&xifo, in[0]));
+    TEST_ASSERT_EQUAL(-1, xifo8_fill_from_fd(&xifo, in[0]));
+    TEST_ASSERT_EQUAL(ENOBUFS, errno);
+    TEST_ASSERT_EQUAL('5', xifo8_read_mr(&xifo, 0));
+    TEST_ASSERT_EQUAL(8, xifo8_drain_to_fd(&xifo, out[1]));
+    TEST_ASSERT_EQUAL(0, xifo8_drain_to_fd(&xifo, out[1]));
+    TEST_ASSERT_EQUAL(8, read(out[0], text, sizeof(text)));
+    TEST_ASSERT_EQUAL_STRING("ef012345", text);
+    close(in[0]);
+    close(in[1]);
+    close(out[0]);
+    close(out[1]);
+    TEST_ASSERT_TRUE(testGuards());
+}
+#endif
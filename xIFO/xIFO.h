@@ -35,6 +35,7 @@
 #define _xifo_H_
  
 #include <inttypes.h>
+#include <stddef.h>
 
 #if !defined(TRUE) || defined(__DOXYGEN__)
 #define TRUE 	(1)
@@ -69,13 +70,155 @@
 #define xIFO_USE_32FLOAT		TRUE
 #endif
 
+#if !defined(xIFO_USE_GENERIC) || defined(__DOXYGEN__)
+#define xIFO_USE_GENERIC		TRUE
+#endif
+
+/**
+ * @brief   Enable the lock-free variants (C11 / C++11 atomics).
+ * @details Enabled automatically when the compiler supports atomics.
+ */
+#if !defined(xIFO_USE_ATOMIC) || defined(__DOXYGEN__)
+#if (defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)) || \
+    (defined(__cplusplus) && (__cplusplus >= 201103L))
+#define xIFO_USE_ATOMIC			TRUE
+#else
+#define xIFO_USE_ATOMIC			FALSE
+#endif
+#endif
+
+/**
+ * @brief   Cache line size used to keep producer and consumer state apart.
+ */
+#if !defined(xIFO_CACHE_LINE) || defined(__DOXYGEN__)
+#define xIFO_CACHE_LINE			64
+#endif
+
+/**
+ * @brief   Enable the C++ helpers that start their own threads.
+ * @details Enabled automatically on hosted C++11 targets.
+ */
+#if !defined(xIFO_USE_THREADS) || defined(__DOXYGEN__)
+#if (xIFO_USE_ATOMIC == TRUE) && defined(__cplusplus) && \
+    (defined(__linux__) || defined(__APPLE__) || defined(_WIN32))
+#define xIFO_USE_THREADS		TRUE
+#else
+#define xIFO_USE_THREADS		FALSE
+#endif
+#endif
+
+/**
+ * @brief   Enable the Linux host extensions (futex, eventfd, ...).
+ * @details Opt-in, the type files then need xifo_linux.c at link time.
+ *          Requires xIFO_USE_ATOMIC.
+ */
+#if !defined(xIFO_USE_LINUX) || defined(__DOXYGEN__)
+#define xIFO_USE_LINUX			FALSE
+#endif
+#if (xIFO_USE_LINUX == TRUE) && ((xIFO_USE_ATOMIC != TRUE) || !defined(__linux__))
+#error "xIFO_USE_LINUX needs atomics and a Linux target"
+#endif
+
+/**
+ * @brief   Enable the C++20 coroutine awaitables.
+ * @details Enabled automatically when the compiler supports coroutines.
+ */
+#if !defined(xIFO_USE_COROUTINE) || defined(__DOXYGEN__)
+#if (xIFO_USE_ATOMIC == TRUE) && defined(__cpp_impl_coroutine) && (__cplusplus >= 202002L)
+#define xIFO_USE_COROUTINE		TRUE
+#else
+#define xIFO_USE_COROUTINE		FALSE
+#endif
+#endif
+
+/**
+ * @brief   Number of polls before a blocking call goes to sleep.
+ */
+#if !defined(xIFO_SPIN_COUNT) || defined(__DOXYGEN__)
+#define xIFO_SPIN_COUNT			100
+#endif
+
+/**
+ * @brief   Timeout value to wait without time limit.
+ */
+#define xIFO_WAIT_FOREVER		0xFFFFFFFFUL
+
+/**
+ * @brief   Pause hint for spin loops.
+ */
+#if !defined(xIFO_CPU_RELAX) || defined(__DOXYGEN__)
+#if defined(__x86_64__) || defined(__i386__)
+#define xIFO_CPU_RELAX()		__builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define xIFO_CPU_RELAX()		__asm__ __volatile__("yield")
+#else
+#define xIFO_CPU_RELAX()
+#endif
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+#ifdef __cplusplus
+#include <atomic>
+#include <type_traits>
+#include <string.h>
+#define xIFO_ATOMIC(type)		std::atomic<type>
+#define xIFO_ALIGNED(n)			alignas(n)
+#else
+#include <stdatomic.h>
+#define xIFO_ATOMIC(type)		_Atomic type
+#define xIFO_ALIGNED(n)			_Alignas(n)
+#endif
+#endif
+
+#if xIFO_USE_THREADS == TRUE
+#include <thread>
+#include <chrono>
+#endif
+
+#if xIFO_USE_COROUTINE == TRUE
+#include <coroutine>
+#endif
+
+#if xIFO_USE_LINUX == TRUE
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* Linux host support */
+uint32_t xifo_time_ms( void );
+void xifo_futex_wait( void *word, uint32_t expected, uint32_t timeout );
+void xifo_futex_wake( void *word, uint32_t count );
+int xifo_eventfd_open( void );
+void xifo_eventfd_signal( int fd );
+void xifo_eventfd_ack( int fd );
+uint32_t xifo_mirror_granularity( void );
+void *xifo_mirror_alloc( uint32_t bytes );
+void xifo_mirror_free( void *pool, uint32_t bytes );
+#ifdef __cplusplus
+}
+#endif
+#endif
+
 #ifdef __cplusplus
 #if xIFO_USE_CPP == TRUE
+#if xIFO_USE_LINUX == TRUE
+#include <sys/mman.h>
+
+/**
+ * @brief   Tag to allocate a Xifo pool with xifo_mirror_alloc.
+ */
+struct XifoMirror {};
+#endif
+
+/**
+ * @brief   Selects the power of two Xifo, Xifo<T, XifoPowerOfTwo>.
+ */
+const bool XifoPowerOfTwo = true;
+
 /**
  * @brief   Circular Buffer object.
  * @details This class holds the object of a circular buffer
  */
-template <class xifo_dtype>
+template <class xifo_dtype, bool xifo_pow2 = false>
 class Xifo
 {
 public:
@@ -87,6 +230,8 @@ public:
     Xifo(uint32_t size)
     {
         startpool = new xifo_dtype[size];
+        dynamic 		= true;
+        imirror 		= false;
         endpool  		= &startpool[size-1];
         isize 			= size;
         ifull 			= 0;
@@ -104,6 +249,8 @@ public:
     Xifo(uint32_t size, xifo_dtype *sp)
     {
         startpool		= sp;
+        dynamic 		= false;
+        imirror 		= false;
         endpool  		= &sp[size-1];
         isize 			= size;
         ifull 			= 0;
@@ -112,6 +259,33 @@ public:
         pwrite			= sp;
     }
 
+#if xIFO_USE_LINUX == TRUE
+    /**
+     * @brief   Initialise xifo on a mirrored pool (Linux).
+     * @details The pool is mapped twice back to back, so peek_contiguous
+     *          returns all used elements as one window.
+     * @note    Only for plain types, elements are not constructed.
+     *          Falls back to dynamic allocation when the pool is not a
+     *          multiple of xifo_mirror_granularity().
+     * @param[in] Number of elements buffer can hold (size).
+     */
+    Xifo(uint32_t size, XifoMirror)
+    {
+        startpool = (xifo_dtype *)xifo_mirror_alloc(size * sizeof(xifo_dtype));
+        imirror 		= (startpool != 0);
+        dynamic 		= !imirror;
+        if(dynamic){
+            startpool = new xifo_dtype[size];
+        }
+        endpool  		= &startpool[size-1];
+        isize 			= size;
+        ifull 			= 0;
+        icount           = 0;
+        read 			= startpool;
+        pwrite			= startpool;
+    }
+#endif
+
     /**
      * @brief   Deinitialise (and deallocate) buffer xifo.
      * @note    Does not clear memory pool.
@@ -119,8 +293,15 @@ public:
     ~Xifo(void)
     {
         if(dynamic){
-            delete startpool;
+            delete[] startpool;
         }
+#if xIFO_USE_LINUX == TRUE
+        if(imirror){
+            /* Same as xifo_mirror_free, kept here so only the mirror
+               constructor needs xifo_linux.c */
+            munmap(startpool, (size_t)isize * sizeof(xifo_dtype) * 2);
+        }
+#endif
     }
 
     /**
@@ -130,7 +311,7 @@ public:
      */
     void clear(void)
     {
-        register xifo_dtype *ptemp = startpool;
+        xifo_dtype *ptemp = startpool;
         while(ptemp <= endpool){
             *ptemp++ = 0;
         }
@@ -143,7 +324,7 @@ public:
      */
     void reset(void)
     {
-        register xifo_dtype *ptemp = startpool;
+        xifo_dtype *ptemp = startpool;
         while(ptemp <= endpool){
             *ptemp++ = 0;
         }
@@ -211,7 +392,7 @@ public:
      */
     xifo_dtype read_lr(uint32_t index)
     {
-        register xifo_dtype *ptemp;
+        xifo_dtype *ptemp;
         /* Verify there is valid data to read */
         if(index+1 > icount){
             return 0;
@@ -246,7 +427,7 @@ public:
      */
     xifo_dtype pop_lr()
     {
-        register xifo_dtype *ptemp;
+        xifo_dtype *ptemp;
         xifo_dtype temp;
         /* Verify there is valid data read */
         if(icount == 0){
@@ -293,7 +474,7 @@ public:
      */
     xifo_dtype read_mr(uint32_t index)
     {
-        register xifo_dtype *ptemp;
+        xifo_dtype *ptemp;
         /* Verify there is valid data to read */
         if(index+1 > icount){
             return 0;
@@ -327,7 +508,7 @@ public:
      */
     xifo_dtype pop_mr()
     {
-        register xifo_dtype temp;
+        xifo_dtype temp;
         /* Verify there is valid data read */
         if(icount == 0){
             return 0;
@@ -352,13 +533,242 @@ public:
         return temp;
     }
 
+    /**
+     * @brief   Write block to buffer
+     *
+     * @warning	Consider this opertaion as atomic!
+     *
+     * @details Same result as n calls to write, but copied in at most two
+     *					segments. Automatically overwrites oldest elements when full.
+     *
+     * @param[in] data	Elements to add, least recent first
+     * @param[in] n			Number of elements
+     *
+     * @return	Number of free buffer elements
+     */
+    uint32_t write_n(const xifo_dtype *data, uint32_t n)
+    {
+        uint32_t w, first;
+        if(n == 0){
+            return isize - icount;
+        }
+        w = (uint32_t)(pwrite - startpool);
+        if(n > isize){
+            /* Only the last size elements remain, at the same place */
+            w = (w + (n - isize) % isize) % isize;
+            data += n - isize;
+            n = isize;
+            pwrite = &startpool[w];
+        }
+        first = isize - w;
+        if(first > n){
+            first = n;
+        }
+        copy(pwrite, data, first);
+        copy(startpool, &data[first], n - first);
+        w += n;
+        if(w >= isize){
+            w -= isize;
+        }
+        pwrite = &startpool[w];
+        read = (w == 0) ? endpool : (pwrite - 1);
+        icount += n;
+        if( icount >= isize ){
+            ifull = 1;
+            icount = isize;
+        }
+        return isize - icount;
+    }
+
+    /**
+     * @brief   Pop block of least recent elements from buffer (fifo)
+     *
+     * @note    Buffer state will be altered
+     *
+     * @warning	Consider this opertaion as atomic!
+     *
+     * @param[out] dst	Destination, least recent first
+     * @param[in] n			Maximum number of elements
+     *
+     * @return	Number of elements popped
+     */
+    uint32_t pop_lr_n(xifo_dtype *dst, uint32_t n)
+    {
+        uint32_t r, first;
+        if(n > icount){
+            n = icount;
+        }
+        if(n == 0){
+            return 0;
+        }
+        r = lr_slot(0);
+        first = isize - r;
+        if(first > n){
+            first = n;
+        }
+        copy(dst, &startpool[r], first);
+        copy(&dst[first], startpool, n - first);
+        /* Empty buffer elements */
+        for(uint32_t i = 0; i < first; i++){
+            startpool[r + i] = 0;
+        }
+        for(uint32_t i = 0; i < n - first; i++){
+            startpool[i] = 0;
+        }
+        icount -= n;
+        if(icount < isize)
+            ifull = 0;
+        return n;
+    }
+
+    /**
+     * @brief   Read block from buffer (lr) Least Recent oriented (fifo)
+     *
+     * @note    Buffer state will be preserved
+     *
+     * @param[out] dst	Destination, least recent first
+     * @param[in] index	Index relative from least recent of the first element
+     * @param[in] n			Maximum number of elements
+     *
+     * @return	Number of elements read
+     */
+    uint32_t read_lr_n(xifo_dtype *dst, uint32_t index, uint32_t n)
+    {
+        uint32_t r, first;
+        if(index >= icount){
+            return 0;
+        }
+        if(n > icount - index){
+            n = icount - index;
+        }
+        r = lr_slot(index);
+        first = isize - r;
+        if(first > n){
+            first = n;
+        }
+        copy(dst, &startpool[r], first);
+        copy(&dst[first], startpool, n - first);
+        return n;
+    }
+
+    /**
+     * @brief   Peek at the least recent elements in place (fifo)
+     *
+     * @note    Buffer state will be preserved
+     *
+     * @details On a mirrored pool this is always every used element.
+     *
+     * @param[out] ptr	Least recent element
+     * @param[out] len	Number of contiguous elements, 0 if empty
+     */
+    void peek_contiguous(const xifo_dtype *&ptr, uint32_t &len)
+    {
+        uint32_t r;
+        if(icount == 0){
+            ptr = startpool;
+            len = 0;
+            return;
+        }
+        r = lr_slot(0);
+        ptr = &startpool[r];
+        len = (imirror || icount < isize - r) ? icount : (isize - r);
+    }
+
+    /**
+     * @brief   Remove least recent elements that were processed in place
+     *
+     * @note    Buffer state will be altered, the elements are not emptied.
+     *
+     * @param[in] n	Number of elements to remove
+     *
+     * @return	Number of elements removed
+     */
+    uint32_t consume(uint32_t n)
+    {
+        if(n > icount){
+            n = icount;
+        }
+        icount -= n;
+        if(icount < isize)
+            ifull = 0;
+        return n;
+    }
+
+    /**
+     * @brief   Visit every element from least recent to most recent (fifo)
+     *
+     * @note    Buffer state will be preserved, fn must not modify the buffer.
+     *
+     * @details Walks both pool segments in a plain loop, fn (a lambda or
+     *          functor taking an element) can be inlined.
+     *
+     * @return	Number of elements visited
+     */
+    template <class xifo_visitor>
+    uint32_t for_each_lr(xifo_visitor fn)
+    {
+        uint32_t r, first, i;
+        if(icount == 0){
+            return 0;
+        }
+        r = lr_slot(0);
+        first = (icount < isize - r) ? icount : (isize - r);
+        for(i = 0; i < first; i++){
+            fn(startpool[r + i]);
+        }
+        for(i = 0; i < icount - first; i++){
+            fn(startpool[i]);
+        }
+        return icount;
+    }
+
+    /**
+     * @brief   Pop every element, least recent first (fifo)
+     *
+     * @note    Buffer state will be altered
+     *
+     * @return	Number of elements popped
+     */
+    template <class xifo_visitor>
+    uint32_t drain_lr(xifo_visitor fn)
+    {
+        uint32_t n = for_each_lr(fn);
+        uint32_t r = lr_slot(0);
+        for(uint32_t i = 0; i < n; i++){
+            startpool[r] = 0;
+            if(++r >= isize){
+                r = 0;
+            }
+        }
+        icount = 0;
+        ifull = 0;
+        return n;
+    }
+
     /* Extractors */
     uint32_t size(){ return isize; }         /**< @brief   Get buffer size */
     uint32_t used(){ return icount; }        /**< @brief   Get number of used elements */
     uint32_t full(){ return ifull; }         /**< @brief   Get full flag */
     uint32_t free(){ return isize-icount; }   /**< @brief   Get number of free elements */
+    bool mirrored(){ return imirror; }       /**< @brief   Get whether pool is mirrored */
 private:
+    /* Slot of the element index positions after the least recent */
+    uint32_t lr_slot(uint32_t index)
+    {
+        uint32_t r = (uint32_t)(read - startpool) + 1 + index + isize - icount;
+        return (r >= isize) ? (r - isize) : r;
+    }
+
+    /* Contiguous copy, the compiler turns this into memcpy for plain types */
+    static void copy(xifo_dtype *dst, const xifo_dtype *src, uint32_t n)
+    {
+        while(n--){
+            *dst++ = *src++;
+        }
+    }
+
     bool dynamic;
+    bool imirror;
     xifo_dtype *startpool;         /**< @brief First element in pool */
     xifo_dtype *endpool;    /**< @brief Last element in pool */
     xifo_dtype *read;       /**< @brief Read pointer */
@@ -368,53 +778,1839 @@ private:
     uint32_t icount;         /**< @brief Number of elements used */
     uint32_t isize;          /**< @brief Size of buffer */
 };
-#endif
-#endif
 
-#ifdef __cplusplus
-extern "C" {
-#endif
-#if xIFO_USE_64BIT == TRUE
 /**
- * @brief   Circular Buffer object.
- * @details This struct holds the object of a circular buffer
+ * @brief   Power of two Circular Buffer object.
+ * @details Free running head index wrapped with a mask, no end of pool
+ *          compare on read, write or pop. Same semantics as Xifo<T>.
  */
-typedef struct  {
-    /* Pointers: */
-    uint64_t *startpool;    /**< @brief First element in pool */
-    uint64_t *endpool;      /**< @brief Last element in pool */
-    uint64_t *read;			/**< @brief Read pointer */
-    uint64_t *write;		/**< @brief Write pointer */
-    /* Variables: */
-    uint32_t full;          /**< @brief Flag indicating buffer is full */
-    uint32_t count;         /**< @brief Number of elements used */
-    uint32_t size;			/**< @brief Size of buffer */
-}xifo64_t;
+template <class xifo_dtype>
+class Xifo<xifo_dtype, XifoPowerOfTwo>
+{
+public:
+    /**
+     * @brief   Initialise xifo.
+     * @note    Does not clear memory pool.
+     * @param[in] Number of elements buffer can hold, rounded up to a power of two.
+     */
+    Xifo(uint32_t size)
+    {
+        uint32_t s = 1;
+        while(s < size){
+            s <<= 1;
+        }
+        startpool = new xifo_dtype[s];
+        dynamic 		= true;
+        mask 			= s - 1;
+        head 			= 0;
+        icount           = 0;
+    }
 
-/**< @brief   Circular Buffer memory pool type. */
-typedef uint64_t xifo64_pool_t;
+    /**
+     * @brief   Initialise xifo.
+     * @note    Does not clear memory pool.
+     * @param[in] Number of elements buffer can hold, rounded down to a power of two.
+     * @param[in] Start of pre-allocated memory pool.
+     */
+    Xifo(uint32_t size, xifo_dtype *sp)
+    {
+        while(size & (size - 1)){
+            size &= size - 1;
+        }
+        startpool		= sp;
+        dynamic 		= false;
+        mask 			= size - 1;
+        head 			= 0;
+        icount           = 0;
+    }
 
-/* xifo Common */
-void xifo64_init( xifo64_t *c, uint32_t size, uint64_t *startpool );
-void xifo64_clear( xifo64_t *c );
-uint32_t xifo64_write( xifo64_t *c, uint64_t data );
-/* FIFO use */
-uint64_t xifo64_read_lr( xifo64_t *c, uint32_t index );
-uint64_t xifo64_pop_lr( xifo64_t *c );
-/* LIFO use */
-uint64_t xifo64_read_mr( xifo64_t *c, uint32_t index );
-uint64_t xifo64_pop_mr( xifo64_t *c );
-/* Extractors */
-uint32_t xifo64_get_size( xifo64_t *c );
-uint32_t xifo64_get_used( xifo64_t *c );
-uint32_t xifo64_get_full( xifo64_t *c );
-uint32_t xifo64_get_free( xifo64_t *c );
-#endif
+    /**
+     * @brief   Deinitialise (and deallocate) buffer xifo.
+     */
+    ~Xifo(void)
+    {
+        if(dynamic){
+            delete[] startpool;
+        }
+    }
 
-#if xIFO_USE_32BIT == TRUE
-/**
- * @brief   Circular Buffer object.
- * @details This struct holds the object of a circular buffer
+    /**
+     * @brief   Clear buffer memory pool
+     */
+    void clear(void)
+    {
+        for(uint32_t i = 0; i <= mask; i++){
+            startpool[i] = 0;
+        }
+    }
+
+    /**
+     * @brief  	Reset buffer
+     */
+    void reset(void)
+    {
+        clear();
+        head 		= 0;
+        icount      = 0;
+    }
+
+    /**
+     * @brief   Write to buffer
+     * @warning	Consider this opertaion as atomic!
+     * @details Automatically overwrites oldest elements when full.
+     * @return	Number of free buffer elements
+     */
+    uint32_t write(xifo_dtype data)
+    {
+        startpool[head++ & mask] = data;
+        /* Saturates at size */
+        icount += (icount <= mask);
+        return (mask + 1) - icount;
+    }
+
+    /**
+     * @brief   Read from buffer (lr) Least Recent oriented (fifo)
+     * @param[in] index   Index relative from least recent
+     * @return	Contents of element or 0 if failed (element can hold 0)
+     */
+    xifo_dtype read_lr(uint32_t index)
+    {
+        if(index >= icount){
+            return 0;
+        }
+        return startpool[(head - icount + index) & mask];
+    }
+
+    /**
+     * @brief   Pop (lr) least recent from buffer (fifo)
+     * @warning	Consider this opertaion as atomic!
+     * @return	Contents of element or 0 if failed (element can hold 0)
+     */
+    xifo_dtype pop_lr()
+    {
+        xifo_dtype temp;
+        if(icount == 0){
+            return 0;
+        }
+        xifo_dtype &slot = startpool[(head - icount) & mask];
+        temp = slot;
+        /* Empty buffer element */
+        slot = 0;
+        icount--;
+        return temp;
+    }
+
+    /**
+     * @brief   Read from buffer (mr) Most Recent oriented (filo)
+     * @param[in] index   Index relative from most recent
+     * @return	Contents of element or 0 if failed (element can hold 0)
+     */
+    xifo_dtype read_mr(uint32_t index)
+    {
+        if(index >= icount){
+            return 0;
+        }
+        return startpool[(head - 1 - index) & mask];
+    }
+
+    /**
+     * @brief   Pop (mr) most recent from buffer (filo)
+     * @warning	Consider this opertaion as atomic!
+     * @return	Contents of element or 0 if failed (element can hold 0)
+     */
+    xifo_dtype pop_mr()
+    {
+        xifo_dtype temp;
+        if(icount == 0){
+            return 0;
+        }
+        xifo_dtype &slot = startpool[--head & mask];
+        temp = slot;
+        /* Empty */
+        slot = 0;
+        icount--;
+        return temp;
+    }
+
+    /* Extractors */
+    uint32_t size(){ return mask + 1; }           /**< @brief   Get buffer size */
+    uint32_t used(){ return icount; }             /**< @brief   Get number of used elements */
+    uint32_t full(){ return icount > mask; }      /**< @brief   Get full flag */
+    uint32_t free(){ return (mask + 1) - icount; } /**< @brief   Get number of free elements */
+private:
+    bool dynamic;
+    xifo_dtype *startpool;  /**< @brief First element in pool */
+    uint32_t mask;          /**< @brief Size of buffer - 1 */
+    uint32_t head;          /**< @brief Free running write index */
+    uint32_t icount;        /**< @brief Number of elements used */
+};
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Bounded multi producer, multi consumer queue object.
+ * @details Lock-free queue after Dmitry Vyukov's bounded MPMC queue.
+ *          Every slot carries a sequence number, producers and consumers
+ *          only contend on their own position counter and the slot itself.
+ * @note    Positions are @p size_t, on targets with a 32 bit @p size_t
+ *          use a power of two size so the slot index survives wrap around.
+ */
+template <class xifo_dtype>
+class XifoMpmc
+{
+public:
+    /**
+     * @brief   Memory pool element.
+     */
+    struct cell {
+        std::atomic<size_t> sequence;   /**< @brief Slot sequence number */
+        xifo_dtype data;                /**< @brief Element */
+    };
+
+    /**
+     * @brief   Initialise queue.
+     * @param[in] Number of elements queue can hold (size).
+     */
+    XifoMpmc(uint32_t size)
+    {
+        pool 			= new cell[size];
+        dynamic 		= true;
+        init(size);
+    }
+
+    /**
+     * @brief   Initialise queue.
+     * @param[in] Number of elements queue can hold (size).
+     * @param[in] Start of pre-allocated memory pool.
+     */
+    XifoMpmc(uint32_t size, cell *sp)
+    {
+        pool 			= sp;
+        dynamic 		= false;
+        init(size);
+    }
+
+    /**
+     * @brief   Deinitialise (and deallocate) queue.
+     */
+    ~XifoMpmc(void)
+    {
+        if(dynamic){
+            delete[] pool;
+        }
+    }
+
+    /**
+     * @brief   Try to write to queue
+     *
+     * @note    Safe to call from any number of threads.
+     *
+     * @details Never overwrites, fails when the queue is full.
+     *
+     * @param[in] data	Data to add to queue
+     *
+     * @return	true if written, false if queue was full
+     */
+    bool try_write(const xifo_dtype &data)
+    {
+        cell *c;
+        size_t pos = ienqueue.load(std::memory_order_relaxed);
+        for(;;){
+            c = &pool[pos % isize];
+            size_t seq = c->sequence.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+            if(dif == 0){
+                /* Slot is free, claim position */
+                if(ienqueue.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)){
+                    break;
+                }
+            }else if(dif < 0){
+                /* Slot still holds an element from the previous lap */
+                return false;
+            }else{
+                /* Another producer claimed it, retry */
+                pos = ienqueue.load(std::memory_order_relaxed);
+            }
+        }
+        c->data = data;
+        /* Publish to consumers */
+        c->sequence.store(pos+1, std::memory_order_release);
+#if xIFO_USE_LINUX == TRUE
+        wake(ipopwait, iwritten);
+#endif
+        return true;
+    }
+
+    /**
+     * @brief   Try to pop (lr) least recent from queue (fifo)
+     *
+     * @note    Safe to call from any number of threads.
+     *
+     * @param[out] data	Contents of element
+     *
+     * @return	true if an element was popped, false if queue was empty
+     */
+    bool try_pop_lr(xifo_dtype &data)
+    {
+        cell *c;
+        size_t pos = idequeue.load(std::memory_order_relaxed);
+        for(;;){
+            c = &pool[pos % isize];
+            size_t seq = c->sequence.load(std::memory_order_acquire);
+            intptr_t dif = (intptr_t)seq - (intptr_t)(pos+1);
+            if(dif == 0){
+                /* Slot is published, claim position */
+                if(idequeue.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)){
+                    break;
+                }
+            }else if(dif < 0){
+                /* Nothing published yet */
+                return false;
+            }else{
+                /* Another consumer claimed it, retry */
+                pos = idequeue.load(std::memory_order_relaxed);
+            }
+        }
+        data = c->data;
+        /* Hand slot to producers of the next lap */
+        c->sequence.store(pos+isize, std::memory_order_release);
+#if xIFO_USE_LINUX == TRUE
+        wake(iwritewait, ipopped);
+#endif
+        return true;
+    }
+
+#if xIFO_USE_LINUX == TRUE
+    /**
+     * @brief   Write to queue, wait while full
+     *
+     * @details Spins xIFO_SPIN_COUNT times, then sleeps on a futex.
+     *          Consumers only make the futex call when a producer sleeps.
+     *
+     * @param[in] data	Data to add to queue
+     * @param[in] timeout	Timeout in milliseconds, 0 to not wait or xIFO_WAIT_FOREVER
+     *
+     * @return	true if written, false on timeout
+     */
+    bool write_wait(const xifo_dtype &data, uint32_t timeout = xIFO_WAIT_FOREVER)
+    {
+        uint32_t spin = 0, start = 0, elapsed, event;
+        for(;;){
+            if(try_write(data)){
+                return true;
+            }
+            if(timeout == 0){
+                return false;
+            }
+            if(spin++ == 0){
+                start = xifo_time_ms();
+            }
+            if(spin <= xIFO_SPIN_COUNT){
+                xIFO_CPU_RELAX();
+                continue;
+            }
+            elapsed = xifo_time_ms() - start;
+            if(timeout != xIFO_WAIT_FOREVER && elapsed >= timeout){
+                return false;
+            }
+            /* Announce, then re-check before sleeping */
+            iwritewait.fetch_add(1, std::memory_order_seq_cst);
+            event = ipopped.load(std::memory_order_seq_cst);
+            if(try_write(data)){
+                iwritewait.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            xifo_futex_wait(&ipopped, event, (timeout == xIFO_WAIT_FOREVER) ? timeout : (timeout - elapsed));
+            iwritewait.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief   Pop (lr) least recent from queue, wait while empty
+     *
+     * @details Spins xIFO_SPIN_COUNT times, then sleeps on a futex.
+     *          Producers only make the futex call when a consumer sleeps.
+     *
+     * @param[out] data	Contents of element
+     * @param[in]  timeout	Timeout in milliseconds, 0 to not wait or xIFO_WAIT_FOREVER
+     *
+     * @return	true if an element was popped, false on timeout
+     */
+    bool pop_lr_wait(xifo_dtype &data, uint32_t timeout = xIFO_WAIT_FOREVER)
+    {
+        uint32_t spin = 0, start = 0, elapsed, event;
+        for(;;){
+            if(try_pop_lr(data)){
+                return true;
+            }
+            if(timeout == 0){
+                return false;
+            }
+            if(spin++ == 0){
+                start = xifo_time_ms();
+            }
+            if(spin <= xIFO_SPIN_COUNT){
+                xIFO_CPU_RELAX();
+                continue;
+            }
+            elapsed = xifo_time_ms() - start;
+            if(timeout != xIFO_WAIT_FOREVER && elapsed >= timeout){
+                return false;
+            }
+            /* Announce, then re-check before sleeping */
+            ipopwait.fetch_add(1, std::memory_order_seq_cst);
+            event = iwritten.load(std::memory_order_seq_cst);
+            if(try_pop_lr(data)){
+                ipopwait.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+            xifo_futex_wait(&iwritten, event, (timeout == xIFO_WAIT_FOREVER) ? timeout : (timeout - elapsed));
+            ipopwait.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+#endif
+
+    /* Extractors, only a snapshot while other threads are running */
+    uint32_t size(){ return isize; }         /**< @brief   Get queue size */
+    uint32_t used(){                         /**< @brief   Get number of used elements */
+        size_t d = idequeue.load(std::memory_order_acquire);
+        size_t e = ienqueue.load(std::memory_order_acquire);
+        return (e > d) ? (uint32_t)((e - d > isize) ? isize : e - d) : 0;
+    }
+    uint32_t full(){ return used() >= isize; } /**< @brief   Get full flag */
+    uint32_t free(){ return isize - used(); } /**< @brief   Get number of free elements */
+private:
+    void init(uint32_t size)
+    {
+        isize 			= size;
+        for(uint32_t i = 0; i < size; i++){
+            pool[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        ienqueue.store(0, std::memory_order_relaxed);
+        idequeue.store(0, std::memory_order_relaxed);
+        iwritten.store(0, std::memory_order_relaxed);
+        ipopped.store(0, std::memory_order_relaxed);
+        iwritewait.store(0, std::memory_order_relaxed);
+        ipopwait.store(0, std::memory_order_relaxed);
+    }
+
+#if xIFO_USE_LINUX == TRUE
+    /* Bump event and wake one sleeper, only when somebody sleeps */
+    void wake(std::atomic<uint32_t> &waiters, std::atomic<uint32_t> &event)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters.load(std::memory_order_relaxed)){
+            event.fetch_add(1, std::memory_order_seq_cst);
+            xifo_futex_wake(&event, 1);
+        }
+    }
+#endif
+
+    bool dynamic;
+    cell *pool;             /**< @brief Memory pool */
+    uint32_t isize;         /**< @brief Size of queue */
+    /* Padding instead of alignas, so new does not need over-aligned support */
+    char ipad0[xIFO_CACHE_LINE];
+    std::atomic<size_t> ienqueue;   /**< @brief Producer position */
+    char ipad1[xIFO_CACHE_LINE];
+    std::atomic<size_t> idequeue;   /**< @brief Consumer position */
+    char ipad2[xIFO_CACHE_LINE];
+    /* Blocking calls: */
+    std::atomic<uint32_t> iwritten;     /**< @brief Futex word, bumped when a sleeping consumer must wake */
+    std::atomic<uint32_t> ipopped;      /**< @brief Futex word, bumped when a sleeping producer must wake */
+    std::atomic<uint32_t> iwritewait;   /**< @brief Number of sleeping producers */
+    std::atomic<uint32_t> ipopwait;     /**< @brief Number of sleeping consumers */
+};
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Bounded work-stealing deque object.
+ * @details Chase-Lev deque. The owning thread uses the most recent end
+ *          like a stack (push_mr / pop_mr) without locks, other threads
+ *          steal from the least recent end (steal_lr) with a single CAS.
+ * @note    Stolen elements are copied before the CAS decides the race,
+ *          so the type must be trivially copyable, such as a pointer or
+ *          XifoTask. Slots are copied word by word with relaxed atomics,
+ *          a torn copy is only possible when the CAS fails.
+ */
+template <class xifo_dtype>
+class XifoDeque
+{
+    static_assert(std::is_trivially_copyable<xifo_dtype>::value,
+                  "XifoDeque needs a trivially copyable type");
+public:
+    /**
+     * @brief   Memory pool element.
+     */
+    struct slot {
+        std::atomic<uintptr_t> word[(sizeof(xifo_dtype) + sizeof(uintptr_t) - 1) / sizeof(uintptr_t)];
+    };
+
+    /**
+     * @brief   Initialise deque.
+     * @param[in] Number of elements deque can hold (size).
+     */
+    XifoDeque(uint32_t size)
+    {
+        pool 			= new slot[size];
+        dynamic 		= true;
+        init(size);
+    }
+
+    /**
+     * @brief   Initialise deque.
+     * @param[in] Number of elements deque can hold (size).
+     * @param[in] Start of pre-allocated memory pool.
+     */
+    XifoDeque(uint32_t size, slot *sp)
+    {
+        pool 			= sp;
+        dynamic 		= false;
+        init(size);
+    }
+
+    /**
+     * @brief   Deinitialise (and deallocate) deque.
+     */
+    ~XifoDeque(void)
+    {
+        if(dynamic){
+            delete[] pool;
+        }
+    }
+
+    /**
+     * @brief   Push most recent (owner only)
+     *
+     * @param[in] data	Data to add to deque
+     *
+     * @return	true if written, false if deque was full
+     */
+    bool push_mr(const xifo_dtype &data)
+    {
+        ptrdiff_t b = ibottom.load(std::memory_order_relaxed);
+        ptrdiff_t t = itop.load(std::memory_order_acquire);
+        if(b - t >= (ptrdiff_t)isize){
+            return false;	/* Full */
+        }
+        put(pool[b % isize], data);
+        std::atomic_thread_fence(std::memory_order_release);
+        ibottom.store(b+1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief   Pop (mr) most recent (owner only)
+     *
+     * @details Races with thieves only for the very last element.
+     *
+     * @param[out] data	Contents of element
+     *
+     * @return	true if an element was popped, false if deque was empty
+     */
+    bool pop_mr(xifo_dtype &data)
+    {
+        ptrdiff_t b = ibottom.load(std::memory_order_relaxed) - 1;
+        ibottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        ptrdiff_t t = itop.load(std::memory_order_relaxed);
+        if(t > b){
+            /* Empty, restore */
+            ibottom.store(b+1, std::memory_order_relaxed);
+            return false;
+        }
+        get(pool[b % isize], data);
+        if(t == b){
+            /* Last element, compete with thieves */
+            bool won = itop.compare_exchange_strong(t, t+1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed);
+            ibottom.store(b+1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Steal (lr) least recent (any thread)
+     *
+     * @param[out] data	Contents of element
+     *
+     * @return	true if an element was stolen, false if empty or lost the race
+     */
+    bool steal_lr(xifo_dtype &data)
+    {
+        ptrdiff_t t = itop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        ptrdiff_t b = ibottom.load(std::memory_order_acquire);
+        if(t >= b){
+            return false;	/* Empty */
+        }
+        get(pool[t % isize], data);
+        return itop.compare_exchange_strong(t, t+1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /* Extractors, only a snapshot while other threads are running */
+    uint32_t size(){ return isize; }         /**< @brief   Get deque size */
+    uint32_t used(){                         /**< @brief   Get number of used elements */
+        ptrdiff_t t = itop.load(std::memory_order_acquire);
+        ptrdiff_t b = ibottom.load(std::memory_order_acquire);
+        return (b > t) ? (uint32_t)(b - t) : 0;
+    }
+    uint32_t free(){ return isize - used(); } /**< @brief   Get number of free elements */
+private:
+    void init(uint32_t size)
+    {
+        isize 			= size;
+        itop.store(0, std::memory_order_relaxed);
+        ibottom.store(0, std::memory_order_relaxed);
+    }
+
+    enum { words = sizeof(((slot *)0)->word) / sizeof(uintptr_t) };
+
+    /* Slot copies, relaxed: the top/bottom indices do the ordering */
+    static void put(slot &s, const xifo_dtype &data)
+    {
+        uintptr_t w[words] = { 0 };
+        memcpy(w, &data, sizeof(xifo_dtype));
+        for(uint32_t i = 0; i < words; i++){
+            s.word[i].store(w[i], std::memory_order_relaxed);
+        }
+    }
+
+    static void get(slot &s, xifo_dtype &data)
+    {
+        uintptr_t w[words];
+        for(uint32_t i = 0; i < words; i++){
+            w[i] = s.word[i].load(std::memory_order_relaxed);
+        }
+        memcpy(&data, w, sizeof(xifo_dtype));
+    }
+
+    bool dynamic;
+    slot *pool;             /**< @brief Memory pool */
+    uint32_t isize;         /**< @brief Size of deque */
+    char ipad0[xIFO_CACHE_LINE];
+    std::atomic<ptrdiff_t> ibottom; /**< @brief Most recent end, owner */
+    char ipad1[xIFO_CACHE_LINE];
+    std::atomic<ptrdiff_t> itop;    /**< @brief Least recent end, thieves */
+    char ipad2[xIFO_CACHE_LINE];
+};
+#endif
+
+#if xIFO_USE_THREADS == TRUE
+/**
+ * @brief   Task for XifoScheduler.
+ */
+struct XifoTask {
+    void (*fn)(void *arg);  /**< @brief Function to run */
+    void *arg;              /**< @brief Argument passed to fn */
+};
+
+/**
+ * @brief   Work-stealing task scheduler.
+ * @details One XifoDeque per worker. Tasks submitted from a worker go to
+ *          its own deque (most recent end, cache hot), idle workers steal
+ *          the least recent task of a random victim. Tasks submitted from
+ *          other threads enter through a shared XifoMpmc.
+ */
+class XifoScheduler
+{
+public:
+    /**
+     * @brief   Start scheduler.
+     * @param[in] workers  Number of worker threads.
+     * @param[in] depth    Number of tasks each deque can hold.
+     */
+    XifoScheduler(uint32_t workers, uint32_t depth = 1024) :
+        inject(depth)
+    {
+        iworkers 		= workers;
+        ipending.store(0, std::memory_order_relaxed);
+        istop.store(false, std::memory_order_relaxed);
+        deques 			= new XifoDeque<XifoTask>*[workers];
+        threads 		= new std::thread[workers];
+        for(uint32_t i = 0; i < workers; i++){
+            deques[i] = new XifoDeque<XifoTask>(depth);
+        }
+        for(uint32_t i = 0; i < workers; i++){
+            threads[i] = std::thread(&XifoScheduler::worker, this, i);
+        }
+    }
+
+    /**
+     * @brief   Run remaining tasks and stop scheduler.
+     */
+    ~XifoScheduler(void)
+    {
+        wait();
+        istop.store(true, std::memory_order_release);
+        /* All workers stopped first, an idle worker may still steal */
+        for(uint32_t i = 0; i < iworkers; i++){
+            threads[i].join();
+        }
+        for(uint32_t i = 0; i < iworkers; i++){
+            delete deques[i];
+        }
+        delete[] threads;
+        delete[] deques;
+    }
+
+    /**
+     * @brief   Submit task
+     *
+     * @details From a worker the task goes to its own deque, runs inline
+     *          when that deque is full. Other threads use the shared queue.
+     *
+     * @param[in] fn	Function to run
+     * @param[in] arg	Argument passed to fn
+     */
+    void submit(void (*fn)(void *), void *arg)
+    {
+        XifoTask task = { fn, arg };
+        XifoScheduler *&owner = current();
+        ipending.fetch_add(1, std::memory_order_relaxed);
+        if(owner == this){
+            if(!deques[index()]->push_mr(task)){
+                run(task);
+            }
+        }else{
+            while(!inject.try_write(task)){
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief   Wait until all submitted tasks have run.
+     * @note    Do not call from a task.
+     */
+    void wait(void)
+    {
+        while(ipending.load(std::memory_order_acquire) != 0){
+            std::this_thread::yield();
+        }
+    }
+
+    uint32_t workers(){ return iworkers; }   /**< @brief   Get number of workers */
+private:
+    /* Worker identity of the calling thread */
+    static XifoScheduler *&current(){ static thread_local XifoScheduler *s = 0; return s; }
+    static uint32_t &index(){ static thread_local uint32_t i = 0; return i; }
+
+    void run(const XifoTask &task)
+    {
+        task.fn(task.arg);
+        ipending.fetch_sub(1, std::memory_order_release);
+    }
+
+    bool find(uint32_t self, uint32_t &seed, XifoTask &task)
+    {
+        if(deques[self]->pop_mr(task)){
+            return true;
+        }
+        if(inject.try_pop_lr(task)){
+            return true;
+        }
+        /* Steal, starting at a random victim */
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t victim = (seed >> 16) % iworkers;
+        for(uint32_t i = 0; i < iworkers; i++){
+            if(victim != self && deques[victim]->steal_lr(task)){
+                return true;
+            }
+            if(++victim == iworkers){
+                victim = 0;
+            }
+        }
+        return false;
+    }
+
+    void worker(uint32_t self)
+    {
+        XifoTask task;
+        uint32_t seed = self + 1;
+        uint32_t idle = 0;
+        current() = this;
+        index() = self;
+        while(!istop.load(std::memory_order_acquire)){
+            if(find(self, seed, task)){
+                run(task);
+                idle = 0;
+            }else if(++idle < 64){
+                std::this_thread::yield();
+            }else{
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    uint32_t iworkers;              /**< @brief Number of workers */
+    XifoDeque<XifoTask> **deques;   /**< @brief One deque per worker */
+    std::thread *threads;           /**< @brief Worker threads */
+    XifoMpmc<XifoTask> inject;      /**< @brief Tasks from outside */
+    std::atomic<uint32_t> ipending; /**< @brief Submitted but not yet run */
+    std::atomic<bool> istop;        /**< @brief Stop request */
+};
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Multi stage pipeline over a single buffer (Disruptor style).
+ * @details One producer writes, then every stage processes each element
+ *          in place and in order. Stage i may only advance up to the
+ *          sequence of stage i-1 (stage 0 up to the producer), the
+ *          producer may only overwrite what the last stage released.
+ *          A stage that falls behind gets everything available in one
+ *          peek. Each stage is run by one thread.
+ * @note    Sequences are @p size_t, on targets with a 32 bit @p size_t
+ *          use a power of two size.
+ */
+template <class xifo_dtype, uint32_t stages>
+class XifoPipeline
+{
+public:
+    /**
+     * @brief   Initialise pipeline.
+     * @param[in] Number of elements buffer can hold (size).
+     */
+    XifoPipeline(uint32_t size)
+    {
+        pool 			= new xifo_dtype[size];
+        dynamic 		= true;
+        init(size);
+    }
+
+    /**
+     * @brief   Initialise pipeline.
+     * @param[in] Number of elements buffer can hold (size).
+     * @param[in] Start of pre-allocated memory pool.
+     */
+    XifoPipeline(uint32_t size, xifo_dtype *sp)
+    {
+        pool 			= sp;
+        dynamic 		= false;
+        init(size);
+    }
+
+    /**
+     * @brief   Deinitialise (and deallocate) pipeline.
+     */
+    ~XifoPipeline(void)
+    {
+        if(dynamic){
+            delete[] pool;
+        }
+    }
+
+    /**
+     * @brief   Claim contiguous slots to write (producer)
+     *
+     * @param[in,out] n	Wanted number of slots, returns number claimed
+     *
+     * @return	Pointer to first slot, n is 0 when the last stage is a lap behind
+     */
+    xifo_dtype *claim(uint32_t &n)
+    {
+        size_t w = icursor.seq.load(std::memory_order_relaxed);
+        size_t room = isize - (size_t)(w - igate);
+        if(room < n){
+            /* Refresh what the last stage released */
+            igate = istage[stages-1].seq.load(std::memory_order_acquire);
+            room = isize - (size_t)(w - igate);
+        }
+        return span(w, room, n);
+    }
+
+    /**
+     * @brief   Publish claimed slots to the first stage (producer)
+     * @param[in] n	Number of slots written
+     */
+    void publish(uint32_t n)
+    {
+        icursor.seq.store(icursor.seq.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    /**
+     * @brief   Write to pipeline (producer)
+     *
+     * @param[in] data	Data to add to pipeline
+     *
+     * @return	true if written, false if full
+     */
+    bool write(const xifo_dtype &data)
+    {
+        uint32_t n = 1;
+        xifo_dtype *p = claim(n);
+        if(n == 0){
+            return false;
+        }
+        *p = data;
+        publish(1);
+        return true;
+    }
+
+    /**
+     * @brief   Get elements ready for a stage
+     *
+     * @details Returns all elements the previous stage (or the producer)
+     *          finished, up to the end of the memory pool.
+     *
+     * @param[in]     stage	Stage number, 0 to stages-1
+     * @param[in,out] n	Maximum number of elements, returns number available
+     *
+     * @return	Pointer to the first element, n is 0 when nothing is ready
+     */
+    xifo_dtype *peek(uint32_t stage, uint32_t &n)
+    {
+        const seq_t &barrier = (stage == 0) ? icursor : istage[stage-1];
+        size_t r = istage[stage].seq.load(std::memory_order_relaxed);
+        size_t ready = (size_t)(istage[stage].barrier - r);
+        if(ready < n){
+            /* Refresh previous stage */
+            istage[stage].barrier = barrier.seq.load(std::memory_order_acquire);
+            ready = (size_t)(istage[stage].barrier - r);
+        }
+        return span(r, ready, n);
+    }
+
+    /**
+     * @brief   Hand processed elements to the next stage
+     * @param[in] stage	Stage number, 0 to stages-1
+     * @param[in] n	Number of elements processed
+     */
+    void release(uint32_t stage, uint32_t n)
+    {
+        istage[stage].seq.store(istage[stage].seq.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    /* Extractors, only a snapshot while other threads are running */
+    uint32_t size(){ return isize; }         /**< @brief   Get buffer size */
+    uint32_t used(){                         /**< @brief   Get number of elements not yet through the last stage */
+        size_t r = istage[stages-1].seq.load(std::memory_order_acquire);
+        return (uint32_t)(icursor.seq.load(std::memory_order_acquire) - r);
+    }
+private:
+    /* Sequence on its own cache line */
+    struct seq_t {
+        std::atomic<size_t> seq;    /**< @brief Next sequence to process */
+        size_t barrier;             /**< @brief Cached sequence of previous stage */
+        char pad[xIFO_CACHE_LINE];
+    };
+
+    void init(uint32_t size)
+    {
+        isize 			= size;
+        igate 			= 0;
+        icursor.seq.store(0, std::memory_order_relaxed);
+        for(uint32_t i = 0; i < stages; i++){
+            istage[i].seq.store(0, std::memory_order_relaxed);
+            istage[i].barrier = 0;
+        }
+    }
+
+    /* Contiguous part of [pos, pos+avail) limited to n */
+    xifo_dtype *span(size_t pos, size_t avail, uint32_t &n)
+    {
+        uint32_t slot = (uint32_t)(pos % isize);
+        if(avail > isize - slot){
+            avail = isize - slot;
+        }
+        if(n > avail){
+            n = (uint32_t)avail;
+        }
+        return &pool[slot];
+    }
+
+    bool dynamic;
+    xifo_dtype *pool;       /**< @brief Memory pool */
+    uint32_t isize;         /**< @brief Size of buffer */
+    size_t igate;           /**< @brief Producer copy of last stage sequence */
+    char ipad[xIFO_CACHE_LINE];
+    seq_t icursor;          /**< @brief Producer sequence */
+    seq_t istage[stages];   /**< @brief Stage sequences */
+};
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Sharded queue, one XifoMpmc per shard with a single consumer.
+ * @details Each producer thread always writes to the same shard, picked
+ *          round robin on its first write, so producers on different
+ *          shards never share a cache line. The consumer drains all
+ *          shards round robin. Order is kept per producer, not globally.
+ * @note    Shards are tied to threads instead of the current CPU, a
+ *          thread that migrates would otherwise break its own ordering.
+ */
+template <class xifo_dtype>
+class XifoSharded
+{
+public:
+    /**
+     * @brief   Initialise sharded queue.
+     * @param[in] Number of shards, typically the number of cores.
+     * @param[in] Number of elements each shard can hold.
+     */
+    XifoSharded(uint32_t shards, uint32_t size)
+    {
+        ishards 		= shards;
+        inext 			= 0;
+        shard 			= new XifoMpmc<xifo_dtype>*[shards];
+        for(uint32_t i = 0; i < shards; i++){
+            shard[i] = new XifoMpmc<xifo_dtype>(size);
+        }
+    }
+
+    /**
+     * @brief   Deinitialise (and deallocate) sharded queue.
+     */
+    ~XifoSharded(void)
+    {
+        for(uint32_t i = 0; i < ishards; i++){
+            delete shard[i];
+        }
+        delete[] shard;
+    }
+
+    /**
+     * @brief   Try to write to the shard of the calling thread
+     *
+     * @param[in] data	Data to add
+     *
+     * @return	true if written, false if that shard was full
+     */
+    bool try_write(const xifo_dtype &data)
+    {
+        return shard[thread_id() % ishards]->try_write(data);
+    }
+
+    /**
+     * @brief   Try to pop from the next non-empty shard (single consumer)
+     *
+     * @param[out] data	Contents of element
+     *
+     * @return	true if an element was popped, false if all shards were empty
+     */
+    bool try_pop_lr(xifo_dtype &data)
+    {
+        for(uint32_t i = 0; i < ishards; i++){
+            uint32_t s = inext;
+            if(++inext == ishards){
+                inext = 0;
+            }
+            if(shard[s]->try_pop_lr(data)){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief   Drain shards in bulk (single consumer)
+     *
+     * @details Empties one shard after the other, starting where the last
+     *          drain stopped, so every shard gets its turn.
+     *
+     * @param[out] dst	Destination
+     * @param[in]  max	Maximum number of elements
+     *
+     * @return	Number of elements popped
+     */
+    uint32_t drain(xifo_dtype *dst, uint32_t max)
+    {
+        uint32_t n = 0;
+        for(uint32_t i = 0; i < ishards && n < max; i++){
+            while(n < max && shard[inext]->try_pop_lr(dst[n])){
+                n++;
+            }
+            if(n < max && ++inext == ishards){
+                inext = 0;
+            }
+        }
+        return n;
+    }
+
+    /* Extractors, only a snapshot while other threads are running */
+    uint32_t shards(){ return ishards; }     /**< @brief   Get number of shards */
+    uint32_t used(){                         /**< @brief   Get number of used elements */
+        uint32_t n = 0;
+        for(uint32_t i = 0; i < ishards; i++){
+            n += shard[i]->used();
+        }
+        return n;
+    }
+private:
+    /* Small id per thread, assigned on first use */
+    static uint32_t thread_id()
+    {
+        static std::atomic<uint32_t> next(0);
+        static thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    uint32_t ishards;                   /**< @brief Number of shards */
+    uint32_t inext;                     /**< @brief Next shard to drain, consumer only */
+    XifoMpmc<xifo_dtype> **shard;       /**< @brief Shards */
+};
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Flat combining front end for a Xifo shared by many threads.
+ * @details A thread posts its operation in a slot and tries to take the
+ *          combiner lock. The thread that gets it applies every pending
+ *          operation to the Xifo in one pass, the others only spin on
+ *          their own slot. The Xifo itself is only touched by one thread
+ *          at a time, so its cache lines stay with the combiner.
+ * @note    A thread uses the same slot every time while it is free, with
+ *          more threads than slots the next free slot is taken.
+ */
+template <class xifo_dtype>
+class XifoCombining
+{
+public:
+    /**
+     * @brief   Initialise combining xifo.
+     * @param[in] Number of elements buffer can hold (size).
+     * @param[in] Number of publication slots, typically the number of threads.
+     */
+    XifoCombining(uint32_t size, uint32_t slots)
+        : ring(size)
+    {
+        init(slots);
+    }
+
+    /**
+     * @brief   Initialise combining xifo.
+     * @param[in] Number of elements buffer can hold (size).
+     * @param[in] Start of pre-allocated memory pool.
+     * @param[in] Number of publication slots, typically the number of threads.
+     */
+    XifoCombining(uint32_t size, xifo_dtype *sp, uint32_t slots)
+        : ring(size, sp)
+    {
+        init(slots);
+    }
+
+    /**
+     * @brief   Deinitialise (and deallocate) combining xifo.
+     */
+    ~XifoCombining(void)
+    {
+        delete[] slot;
+    }
+
+    /**
+     * @brief   Write to buffer, see Xifo::write
+     *
+     * @param[in] data	Data to add to buffer
+     *
+     * @return	Number of free buffer elements
+     */
+    uint32_t write(const xifo_dtype &data)
+    {
+        return post(OP_WRITE, &data, 0);
+    }
+
+    /**
+     * @brief   Pop (lr) least recent from buffer (fifo)
+     *
+     * @param[out] data	Contents of element
+     *
+     * @return	true if an element was popped, false if empty
+     */
+    bool pop_lr(xifo_dtype &data)
+    {
+        return post(OP_POP_LR, 0, &data) != 0;
+    }
+
+    /**
+     * @brief   Pop (mr) most recent from buffer (filo)
+     *
+     * @param[out] data	Contents of element
+     *
+     * @return	true if an element was popped, false if empty
+     */
+    bool pop_mr(xifo_dtype &data)
+    {
+        return post(OP_POP_MR, 0, &data) != 0;
+    }
+
+    /* Extractors */
+    uint32_t size(){ return ring.size(); }   /**< @brief   Get buffer size */
+private:
+    enum {
+        SLOT_FREE = 0,
+        SLOT_CLAIMED,
+        OP_WRITE,
+        OP_POP_LR,
+        OP_POP_MR,
+        SLOT_DONE
+    };
+
+    struct record {
+        std::atomic<uint32_t> state;    /**< @brief SLOT_*, OP_* while pending */
+        uint32_t result;
+        xifo_dtype data;
+        char pad[xIFO_CACHE_LINE];      /**< @brief Keep records apart */
+    };
+
+    void init(uint32_t slots)
+    {
+        islots 			= slots;
+        slot 			= new record[slots];
+        for(uint32_t i = 0; i < slots; i++){
+            slot[i].state.store(SLOT_FREE, std::memory_order_relaxed);
+        }
+        lock.store(false, std::memory_order_relaxed);
+    }
+
+    /* Post operation, combine or wait until it is done */
+    uint32_t post(uint32_t op, const xifo_dtype *in, xifo_dtype *out)
+    {
+        record *r;
+        uint32_t result;
+        uint32_t i = thread_id() % islots;
+        uint32_t spin = 0;
+        for(;;){
+            uint32_t expected = SLOT_FREE;
+            if(slot[i].state.load(std::memory_order_relaxed) == SLOT_FREE &&
+               slot[i].state.compare_exchange_weak(expected, SLOT_CLAIMED,
+                    std::memory_order_acquire, std::memory_order_relaxed)){
+                break;
+            }
+            if(++i == islots){
+                /* More threads than slots, wait for one to come free */
+                i = 0;
+                xIFO_CPU_RELAX();
+            }
+        }
+        r = &slot[i];
+        if(in){
+            r->data = *in;
+        }
+        r->state.store(op, std::memory_order_release);
+        while(r->state.load(std::memory_order_acquire) != SLOT_DONE){
+            /* Test and test-and-set, waiters only read the lock line */
+            if(!lock.load(std::memory_order_relaxed) &&
+               !lock.exchange(true, std::memory_order_acquire)){
+                combine();
+                lock.store(false, std::memory_order_release);
+                continue;
+            }
+            if(++spin > xIFO_SPIN_COUNT){
+#if xIFO_USE_THREADS == TRUE
+                std::this_thread::yield();
+#endif
+            }else{
+                xIFO_CPU_RELAX();
+            }
+        }
+        result = r->result;
+        if(out && result){
+            *out = r->data;
+        }
+        r->state.store(SLOT_FREE, std::memory_order_release);
+        return result;
+    }
+
+    /* Apply all pending operations, combiner only */
+    void combine(void)
+    {
+        for(uint32_t i = 0; i < islots; i++){
+            record *r = &slot[i];
+            switch(r->state.load(std::memory_order_acquire)){
+            case OP_WRITE:
+                r->result = ring.write(r->data);
+                break;
+            case OP_POP_LR:
+                r->result = ring.used();
+                if(r->result){
+                    r->data = ring.pop_lr();
+                }
+                break;
+            case OP_POP_MR:
+                r->result = ring.used();
+                if(r->result){
+                    r->data = ring.pop_mr();
+                }
+                break;
+            default:
+                continue;
+            }
+            r->state.store(SLOT_DONE, std::memory_order_release);
+        }
+    }
+
+    /* Small id per thread, assigned on first use */
+    static uint32_t thread_id()
+    {
+        static std::atomic<uint32_t> next(0);
+        static thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    Xifo<xifo_dtype> ring;              /**< @brief Combined buffer */
+    std::atomic<bool> lock;             /**< @brief Combiner lock */
+    uint32_t islots;                    /**< @brief Number of slots */
+    record *slot;                       /**< @brief Publication slots */
+};
+#endif
+
+#if xIFO_USE_COROUTINE == TRUE
+/**
+ * @brief   Xifo with C++20 awaitable write and pop.
+ * @details co_await async_pop_lr() suspends while the buffer is empty,
+ *          co_await async_write() while it is full (it never overwrites).
+ *          Waiting coroutines are kept in an intrusive list inside their
+ *          own awaiter, so waiting does not allocate. A writer hands its
+ *          element straight to the oldest waiting consumer.
+ * @note    Resumed coroutines are passed to the executor hook. Without one
+ *          they run from a per thread ready list: the outermost resume
+ *          drains it, nested wakeups only queue and a waiting coroutine
+ *          hands over to the next ready one by symmetric transfer, so the
+ *          stack does not grow with the number of hand-offs.
+ * @warning A suspended coroutine must not be destroyed while it waits.
+ */
+template <class xifo_dtype>
+class XifoAsync
+{
+public:
+    /** @brief Executor hook, schedules the coroutine @p h */
+    typedef void (*executor_t)(std::coroutine_handle<> h, void *ctx);
+
+    /**
+     * @brief   Initialise async xifo.
+     * @param[in] Number of elements buffer can hold (size).
+     * @param[in] Executor hook, or 0 to resume inline.
+     * @param[in] Context passed to the executor hook.
+     */
+    XifoAsync(uint32_t size, executor_t post = 0, void *ctx = 0)
+        : ring(size)
+    {
+        init(post, ctx);
+    }
+
+    /**
+     * @brief   Initialise async xifo.
+     * @param[in] Number of elements buffer can hold (size).
+     * @param[in] Start of pre-allocated memory pool.
+     * @param[in] Executor hook, or 0 to resume inline.
+     * @param[in] Context passed to the executor hook.
+     */
+    XifoAsync(uint32_t size, xifo_dtype *sp, executor_t post = 0, void *ctx = 0)
+        : ring(size, sp)
+    {
+        init(post, ctx);
+    }
+
+    /** @brief Waiting coroutine, lives in the awaiter */
+    struct waiter {
+        waiter *next;
+        std::coroutine_handle<> handle;
+        xifo_dtype data;
+    };
+
+    /** @brief Awaiter returned by async_pop_lr() */
+    struct pop_awaiter : waiter {
+        XifoAsync *owner;
+        bool await_ready() { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) { return owner->suspend_pop(this, h); }
+        xifo_dtype await_resume() { return this->data; }
+    };
+
+    /** @brief Awaiter returned by async_write() */
+    struct write_awaiter : waiter {
+        XifoAsync *owner;
+        bool await_ready() { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) { return owner->suspend_write(this, h); }
+        void await_resume() {}
+    };
+
+    /**
+     * @brief   Pop (lr) least recent, suspend while empty
+     *
+     * @return	Awaitable, co_await yields the element
+     */
+    pop_awaiter async_pop_lr()
+    {
+        pop_awaiter a;
+        a.owner = this;
+        return a;
+    }
+
+    /**
+     * @brief   Write, suspend while full
+     *
+     * @param[in] data	Data to add to buffer
+     *
+     * @return	Awaitable
+     */
+    write_awaiter async_write(const xifo_dtype &data)
+    {
+        write_awaiter a;
+        a.owner = this;
+        a.data = data;
+        return a;
+    }
+
+    /**
+     * @brief   Write without waiting
+     *
+     * @param[in] data	Data to add to buffer
+     *
+     * @return	true if written, false if full
+     */
+    bool try_write(const xifo_dtype &data)
+    {
+        acquire();
+        if(!pops && ring.free() == 0){
+            release();
+            return false;
+        }
+        waiter *w = put(data);
+        release();
+        resume(w);
+        return true;
+    }
+
+    /**
+     * @brief   Pop (lr) least recent without waiting
+     *
+     * @param[out] data	Contents of element
+     *
+     * @return	true if an element was popped, false if empty
+     */
+    bool try_pop_lr(xifo_dtype &data)
+    {
+        acquire();
+        if(ring.used() == 0){
+            release();
+            return false;
+        }
+        waiter *w = take(data);
+        release();
+        resume(w);
+        return true;
+    }
+
+    /* Extractors, only a snapshot while other threads are running */
+    uint32_t size(){ return ring.size(); }   /**< @brief   Get buffer size */
+    uint32_t used(){ return ring.used(); }   /**< @brief   Get number of used elements */
+private:
+    void init(executor_t post, void *ctx)
+    {
+        ipost 			= post;
+        ictx 			= ctx;
+        pops 			= 0;
+        pops_tail 		= 0;
+        writes 			= 0;
+        writes_tail 	= 0;
+        lock.clear();
+    }
+
+    void acquire(void)
+    {
+        while(lock.test_and_set(std::memory_order_acquire)){
+            xIFO_CPU_RELAX();
+        }
+    }
+
+    void release(void)
+    {
+        lock.clear(std::memory_order_release);
+    }
+
+    static void enqueue(waiter **head, waiter **tail, waiter *w)
+    {
+        w->next = 0;
+        if(*tail){
+            (*tail)->next = w;
+        }else{
+            *head = w;
+        }
+        *tail = w;
+    }
+
+    static waiter *dequeue(waiter **head, waiter **tail)
+    {
+        waiter *w = *head;
+        if(w){
+            *head = w->next;
+            if(!*head){
+                *tail = 0;
+            }
+        }
+        return w;
+    }
+
+    /* Store data, or hand it to a waiting consumer. Lock held */
+    waiter *put(const xifo_dtype &data)
+    {
+        waiter *w = dequeue(&pops, &pops_tail);
+        if(w){
+            w->data = data;
+            return w;
+        }
+        ring.write(data);
+        return 0;
+    }
+
+    /* Take oldest, let a waiting producer fill the slot. Lock held */
+    waiter *take(xifo_dtype &data)
+    {
+        waiter *w = dequeue(&writes, &writes_tail);
+        data = ring.pop_lr();
+        if(w){
+            ring.write(w->data);
+        }
+        return w;
+    }
+
+    /* Coroutines woken on this thread while a resume is running */
+    struct ready_list {
+        waiter *head;
+        waiter *tail;
+        bool running;
+    };
+
+    static ready_list &ready()
+    {
+        static thread_local ready_list r = { 0, 0, false };
+        return r;
+    }
+
+    void resume(waiter *w)
+    {
+        if(!w){
+            return;
+        }
+        if(ipost){
+            ipost(w->handle, ictx);
+            return;
+        }
+        ready_list &r = ready();
+        enqueue(&r.head, &r.tail, w);
+        if(r.running){
+            return;
+        }
+        r.running = true;
+        while((w = dequeue(&r.head, &r.tail))){
+            w->handle.resume();
+        }
+        r.running = false;
+    }
+
+    /* Self is waiting, continue with the next ready coroutine */
+    static std::coroutine_handle<> next_ready(void)
+    {
+        ready_list &r = ready();
+        waiter *w = r.running ? dequeue(&r.head, &r.tail) : 0;
+        if(w){
+            return w->handle;
+        }
+        return std::noop_coroutine();
+    }
+
+    std::coroutine_handle<> suspend_pop(waiter *self, std::coroutine_handle<> h)
+    {
+        self->handle = h;
+        acquire();
+        if(ring.used()){
+            waiter *w = take(self->data);
+            release();
+            resume(w);
+            return h;
+        }
+        enqueue(&pops, &pops_tail, self);
+        release();
+        return next_ready();
+    }
+
+    std::coroutine_handle<> suspend_write(waiter *self, std::coroutine_handle<> h)
+    {
+        self->handle = h;
+        acquire();
+        if(pops || ring.free()){
+            waiter *w = put(self->data);
+            release();
+            resume(w);
+            return h;
+        }
+        enqueue(&writes, &writes_tail, self);
+        release();
+        return next_ready();
+    }
+
+    Xifo<xifo_dtype> ring;              /**< @brief Buffer */
+    std::atomic_flag lock;              /**< @brief Protects ring and wait lists */
+    waiter *pops;                       /**< @brief Consumers waiting for data */
+    waiter *pops_tail;                  /**< @brief Last waiting consumer */
+    waiter *writes;                     /**< @brief Producers waiting for space */
+    waiter *writes_tail;                /**< @brief Last waiting producer */
+    executor_t ipost;                   /**< @brief Executor hook */
+    void *ictx;                         /**< @brief Executor context */
+};
+#endif
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#if xIFO_USE_GENERIC == TRUE
+/**
+ * @brief   Circular Buffer object with runtime element size.
+ * @details Elements of any size (structs) are stored inline in the pool and
+ *          copied with a routine picked at init for the element size.
+ */
+typedef struct  {
+    /* Pointers: */
+    uint8_t *startpool;     /**< @brief First element in pool */
+    void (*copy)(void *dst, const void *src, uint32_t esize);  /**< @brief Element copy */
+    /* Variables: */
+    uint32_t esize;         /**< @brief Size of one element in bytes */
+    uint32_t read;          /**< @brief Index of most recent element */
+    uint32_t write;         /**< @brief Index of next element to write */
+    uint32_t full;          /**< @brief Flag indicating buffer is full */
+    uint32_t count;         /**< @brief Number of elements used */
+    uint32_t size;          /**< @brief Size of buffer */
+}xifo_t;
+
+/* xifo Common */
+void xifo_init( xifo_t *c, uint32_t size, uint32_t esize, void *startpool );
+void xifo_clear( xifo_t *c );
+uint32_t xifo_write( xifo_t *c, const void *data );
+/* FIFO use */
+uint32_t xifo_read_lr( xifo_t *c, uint32_t index, void *data );
+uint32_t xifo_pop_lr( xifo_t *c, void *data );
+/* LIFO use */
+uint32_t xifo_read_mr( xifo_t *c, uint32_t index, void *data );
+uint32_t xifo_pop_mr( xifo_t *c, void *data );
+/* Extractors */
+uint32_t xifo_get_size( xifo_t *c );
+uint32_t xifo_get_used( xifo_t *c );
+uint32_t xifo_get_full( xifo_t *c );
+uint32_t xifo_get_free( xifo_t *c );
+uint32_t xifo_get_esize( xifo_t *c );
+/* Visitor use */
+uint32_t xifo_for_each_lr( xifo_t *c, void (*fn)( const void *data, void *ctx ), void *ctx );
+uint32_t xifo_drain_lr( xifo_t *c, void (*fn)( const void *data, void *ctx ), void *ctx );
+
+/**
+ * @brief   Heap entry of a merger, one per non-empty ring.
+ */
+typedef struct  {
+    uint32_t ts;            /**< @brief Timestamp of the least recent record */
+    uint32_t ring;          /**< @brief Ring index */
+}xifo_merge_node_t;
+
+/**
+ * @brief   K-way merge of rings of timestamped records.
+ * @details Pops records of N xifo_t rings in timestamp order with a min-heap
+ *          of the ring heads, O(log N) per record.
+ */
+typedef struct  {
+    xifo_t *rings;          /**< @brief Rings to merge, same element size */
+    xifo_merge_node_t *heap;    /**< @brief Heap, one node per ring */
+    uint32_t count;         /**< @brief Number of rings */
+    uint32_t offset;        /**< @brief Offset of the uint32_t timestamp in a record */
+    uint32_t strict;        /**< @brief Stop a batch when a ring runs empty */
+}xifo_merge_t;
+
+/* Merge use */
+void xifo_merge_init( xifo_merge_t *m, xifo_t *rings, uint32_t count, xifo_merge_node_t *heap, uint32_t offset, uint32_t strict );
+uint32_t xifo_merge_pop_n( xifo_merge_t *m, void *dst, uint32_t n );
+#endif
+
+#if xIFO_USE_64BIT == TRUE
+/**
+ * @brief   Circular Buffer object.
+ * @details This struct holds the object of a circular buffer
+ */
+typedef struct  {
+    /* Pointers: */
+    uint64_t *startpool;    /**< @brief First element in pool */
+    uint64_t *endpool;      /**< @brief Last element in pool */
+    uint64_t *read;			/**< @brief Read pointer */
+    uint64_t *write;		/**< @brief Write pointer */
+    /* Variables: */
+    uint32_t full;          /**< @brief Flag indicating buffer is full */
+    uint32_t count;         /**< @brief Number of elements used */
+    uint32_t size;			/**< @brief Size of buffer */
+}xifo64_t;
+
+/**< @brief   Circular Buffer memory pool type. */
+typedef uint64_t xifo64_pool_t;
+
+/* xifo Common */
+void xifo64_init( xifo64_t *c, uint32_t size, uint64_t *startpool );
+void xifo64_clear( xifo64_t *c );
+uint32_t xifo64_write( xifo64_t *c, uint64_t data );
+/* FIFO use */
+uint64_t xifo64_read_lr( xifo64_t *c, uint32_t index );
+uint64_t xifo64_pop_lr( xifo64_t *c );
+/* LIFO use */
+uint64_t xifo64_read_mr( xifo64_t *c, uint32_t index );
+uint64_t xifo64_pop_mr( xifo64_t *c );
+/* Extractors */
+uint32_t xifo64_get_size( xifo64_t *c );
+uint32_t xifo64_get_used( xifo64_t *c );
+uint32_t xifo64_get_full( xifo64_t *c );
+uint32_t xifo64_get_free( xifo64_t *c );
+/* Bulk use */
+uint32_t xifo64_write_n( xifo64_t *c, const uint64_t *data, uint32_t n );
+uint32_t xifo64_pop_lr_n( xifo64_t *c, uint64_t *dst, uint32_t n );
+uint32_t xifo64_read_lr_n( xifo64_t *c, uint64_t *dst, uint32_t index, uint32_t n );
+/* Zero-copy use */
+void xifo64_peek_contiguous( xifo64_t *c, const uint64_t **ptr, uint32_t *len );
+void xifo64_peek_segments( xifo64_t *c, const uint64_t **ptr1, uint32_t *len1, const uint64_t **ptr2, uint32_t *len2 );
+uint32_t xifo64_consume( xifo64_t *c, uint32_t n );
+/* Visitor use */
+uint32_t xifo64_for_each_lr( xifo64_t *c, void (*fn)( uint64_t data, void *ctx ), void *ctx );
+uint32_t xifo64_drain_lr( xifo64_t *c, void (*fn)( uint64_t data, void *ctx ), void *ctx );
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Lock-free single producer, single consumer circular buffer object.
+ * @details The producer owns @p write, the consumer owns @p read.
+ *          Both positions run from 0 to 2*size so no shared count is needed,
+ *          each side lives on its own cache line.
+ */
+typedef struct  {
+    /* Shared, constant after init: */
+    uint64_t *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    /* Producer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) write;    /**< @brief Write position */
+    uint32_t rcache;        /**< @brief Producer copy of read position */
+    uint32_t reserved;      /**< @brief Reserved, not yet committed slots */
+    xIFO_ATOMIC(uint32_t) rwait;    /**< @brief Consumer is sleeping */
+    int rfd;                /**< @brief eventfd signalled on empty to non-empty, -1 if unused */
+    /* Consumer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) read;     /**< @brief Read position */
+    uint32_t wcache;        /**< @brief Consumer copy of write position */
+    uint32_t peeked;        /**< @brief Peeked, not yet released elements */
+    xIFO_ATOMIC(uint32_t) wwait;    /**< @brief Producer is sleeping */
+    int wfd;                /**< @brief eventfd signalled on full to non-full, -1 if unused */
+}xifo64_spsc_t;
+
+/* SPSC use */
+void xifo64_spsc_init( xifo64_spsc_t *c, uint32_t size, uint64_t *startpool );
+uint32_t xifo64_spsc_write( xifo64_spsc_t *c, uint64_t data );
+uint32_t xifo64_spsc_pop_lr( xifo64_spsc_t *c, uint64_t *data );
+uint64_t xifo64_spsc_read_lr( xifo64_spsc_t *c, uint32_t index );
+uint32_t xifo64_spsc_reserve( xifo64_spsc_t *c, uint64_t **ptr, uint32_t n );
+void xifo64_spsc_commit( xifo64_spsc_t *c, uint32_t n );
+uint32_t xifo64_spsc_peek( xifo64_spsc_t *c, const uint64_t **ptr, uint32_t n );
+void xifo64_spsc_release( xifo64_spsc_t *c, uint32_t n );
+uint32_t xifo64_spsc_get_size( xifo64_spsc_t *c );
+uint32_t xifo64_spsc_get_used( xifo64_spsc_t *c );
+uint32_t xifo64_spsc_get_full( xifo64_spsc_t *c );
+uint32_t xifo64_spsc_get_free( xifo64_spsc_t *c );
+#if xIFO_USE_LINUX == TRUE
+uint32_t xifo64_spsc_write_wait( xifo64_spsc_t *c, uint64_t data, uint32_t timeout );
+uint32_t xifo64_spsc_pop_lr_wait( xifo64_spsc_t *c, uint64_t *data, uint32_t timeout );
+void xifo64_spsc_set_eventfd( xifo64_spsc_t *c, int readable, int writable );
+#endif
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Single writer, multi reader broadcast circular buffer object.
+ * @details Written once, every reader has its own cursor. The writer
+ *          never waits, readers that are lapped skip ahead and count the
+ *          elements they lost.
+ */
+typedef struct  {
+    uint64_t *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    uint32_t span;          /**< @brief Sequence wrap, multiple of size */
+    uint32_t windex;        /**< @brief Writer slot index */
+    uint32_t wseq;          /**< @brief Writer copy of sequence */
+    xIFO_ATOMIC(uint32_t) wrapped;  /**< @brief Sequence wrapped at least once */
+    xIFO_ATOMIC(uint32_t) seq;  /**< @brief Published sequence (generation) */
+}xifo64_bc_t;
+
+/**
+ * @brief   Broadcast reader cursor.
+ */
+typedef struct  {
+    uint32_t seq;           /**< @brief Sequence of next element to read */
+    uint32_t index;         /**< @brief Slot index of next element to read */
+    uint32_t lost;          /**< @brief Elements lost by being lapped */
+}xifo64_bc_reader_t;
+
+/* Broadcast use */
+void xifo64_bc_init( xifo64_bc_t *c, uint32_t size, uint64_t *startpool );
+void xifo64_bc_write( xifo64_bc_t *c, uint64_t data );
+void xifo64_bc_reader_init( xifo64_bc_t *c, xifo64_bc_reader_t *r );
+uint32_t xifo64_bc_read_lr( xifo64_bc_t *c, xifo64_bc_reader_t *r, uint64_t *data );
+uint32_t xifo64_bc_get_used( xifo64_bc_t *c, xifo64_bc_reader_t *r );
+uint32_t xifo64_bc_get_lost( xifo64_bc_reader_t *r );
+uint32_t xifo64_bc_snapshot_mr( xifo64_bc_t *c, uint64_t *dst, uint32_t n );
+#endif
+
+/**
+ * @brief   Power of two circular buffer object.
+ * @details Free running head index wrapped with a mask, no end of pool
+ *          compare on read, write or pop. Same semantics as xifo64_t.
+ */
+typedef struct  {
+    uint64_t *startpool;    /**< @brief First element in pool */
+    uint32_t mask;          /**< @brief Size of buffer - 1 */
+    uint32_t head;          /**< @brief Free running write index */
+    uint32_t count;         /**< @brief Number of elements used */
+}xifo64_p2_t;
+
+/* Power of two use */
+void xifo64_p2_init( xifo64_p2_t *c, uint32_t size, uint64_t *startpool );
+void xifo64_p2_clear( xifo64_p2_t *c );
+uint32_t xifo64_p2_write( xifo64_p2_t *c, uint64_t data );
+uint64_t xifo64_p2_read_lr( xifo64_p2_t *c, uint32_t index );
+uint64_t xifo64_p2_read_mr( xifo64_p2_t *c, uint32_t index );
+uint64_t xifo64_p2_pop_lr( xifo64_p2_t *c );
+uint64_t xifo64_p2_pop_mr( xifo64_p2_t *c );
+uint32_t xifo64_p2_get_size( xifo64_p2_t *c );
+uint32_t xifo64_p2_get_used( xifo64_p2_t *c );
+uint32_t xifo64_p2_get_full( xifo64_p2_t *c );
+uint32_t xifo64_p2_get_free( xifo64_p2_t *c );
+
+/**
+ * @brief   Compact circular buffer object, at most 65535 elements.
+ * @details Base pointer and 16 bit indices, 16 bytes on 64 bit hosts
+ *          instead of the 48 of xifo64_t. Same semantics as xifo64_t,
+ *          full and the end of pool are derived.
+ */
+typedef struct  {
+    uint64_t *startpool;    /**< @brief First element in pool */
+    uint16_t size;          /**< @brief Size of buffer */
+    uint16_t head;          /**< @brief Index of next write */
+    uint16_t count;         /**< @brief Number of elements used */
+}xifo64_compact_t;
+
+/* Compact use */
+void xifo64_compact_init( xifo64_compact_t *c, uint32_t size, uint64_t *startpool );
+void xifo64_compact_clear( xifo64_compact_t *c );
+uint32_t xifo64_compact_write( xifo64_compact_t *c, uint64_t data );
+uint64_t xifo64_compact_read_lr( xifo64_compact_t *c, uint32_t index );
+uint64_t xifo64_compact_read_mr( xifo64_compact_t *c, uint32_t index );
+uint64_t xifo64_compact_pop_lr( xifo64_compact_t *c );
+uint64_t xifo64_compact_pop_mr( xifo64_compact_t *c );
+uint32_t xifo64_compact_get_size( xifo64_compact_t *c );
+uint32_t xifo64_compact_get_used( xifo64_compact_t *c );
+uint32_t xifo64_compact_get_full( xifo64_compact_t *c );
+uint32_t xifo64_compact_get_free( xifo64_compact_t *c );
+
+
+#endif
+
+#if xIFO_USE_32BIT == TRUE
+/**
+ * @brief   Circular Buffer object.
+ * @details This struct holds the object of a circular buffer
  */
 typedef struct  {
     /* Pointers: */
@@ -446,6 +2642,178 @@ uint32_t xifo32_get_size( xifo32_t *c );
 uint32_t xifo32_get_used( xifo32_t *c );
 uint32_t xifo32_get_full( xifo32_t *c );
 uint32_t xifo32_get_free( xifo32_t *c );
+/* Bulk use */
+uint32_t xifo32_write_n( xifo32_t *c, const uint32_t *data, uint32_t n );
+uint32_t xifo32_pop_lr_n( xifo32_t *c, uint32_t *dst, uint32_t n );
+uint32_t xifo32_read_lr_n( xifo32_t *c, uint32_t *dst, uint32_t index, uint32_t n );
+/* Zero-copy use */
+void xifo32_peek_contiguous( xifo32_t *c, const uint32_t **ptr, uint32_t *len );
+void xifo32_peek_segments( xifo32_t *c, const uint32_t **ptr1, uint32_t *len1, const uint32_t **ptr2, uint32_t *len2 );
+uint32_t xifo32_consume( xifo32_t *c, uint32_t n );
+/* Visitor use */
+uint32_t xifo32_for_each_lr( xifo32_t *c, void (*fn)( uint32_t data, void *ctx ), void *ctx );
+uint32_t xifo32_drain_lr( xifo32_t *c, void (*fn)( uint32_t data, void *ctx ), void *ctx );
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Lock-free single producer, single consumer circular buffer object.
+ * @details The producer owns @p write, the consumer owns @p read.
+ *          Both positions run from 0 to 2*size so no shared count is needed,
+ *          each side lives on its own cache line.
+ */
+typedef struct  {
+    /* Shared, constant after init: */
+    uint32_t *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    /* Producer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) write;    /**< @brief Write position */
+    uint32_t rcache;        /**< @brief Producer copy of read position */
+    uint32_t reserved;      /**< @brief Reserved, not yet committed slots */
+    xIFO_ATOMIC(uint32_t) rwait;    /**< @brief Consumer is sleeping */
+    int rfd;                /**< @brief eventfd signalled on empty to non-empty, -1 if unused */
+    /* Consumer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) read;     /**< @brief Read position */
+    uint32_t wcache;        /**< @brief Consumer copy of write position */
+    uint32_t peeked;        /**< @brief Peeked, not yet released elements */
+    xIFO_ATOMIC(uint32_t) wwait;    /**< @brief Producer is sleeping */
+    int wfd;                /**< @brief eventfd signalled on full to non-full, -1 if unused */
+}xifo32_spsc_t;
+
+/* SPSC use */
+void xifo32_spsc_init( xifo32_spsc_t *c, uint32_t size, uint32_t *startpool );
+uint32_t xifo32_spsc_write( xifo32_spsc_t *c, uint32_t data );
+uint32_t xifo32_spsc_pop_lr( xifo32_spsc_t *c, uint32_t *data );
+uint32_t xifo32_spsc_read_lr( xifo32_spsc_t *c, uint32_t index );
+uint32_t xifo32_spsc_reserve( xifo32_spsc_t *c, uint32_t **ptr, uint32_t n );
+void xifo32_spsc_commit( xifo32_spsc_t *c, uint32_t n );
+uint32_t xifo32_spsc_peek( xifo32_spsc_t *c, const uint32_t **ptr, uint32_t n );
+void xifo32_spsc_release( xifo32_spsc_t *c, uint32_t n );
+uint32_t xifo32_spsc_get_size( xifo32_spsc_t *c );
+uint32_t xifo32_spsc_get_used( xifo32_spsc_t *c );
+uint32_t xifo32_spsc_get_full( xifo32_spsc_t *c );
+uint32_t xifo32_spsc_get_free( xifo32_spsc_t *c );
+#if xIFO_USE_LINUX == TRUE
+uint32_t xifo32_spsc_write_wait( xifo32_spsc_t *c, uint32_t data, uint32_t timeout );
+uint32_t xifo32_spsc_pop_lr_wait( xifo32_spsc_t *c, uint32_t *data, uint32_t timeout );
+void xifo32_spsc_set_eventfd( xifo32_spsc_t *c, int readable, int writable );
+#endif
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Single writer, multi reader broadcast circular buffer object.
+ * @details Written once, every reader has its own cursor. The writer
+ *          never waits, readers that are lapped skip ahead and count the
+ *          elements they lost.
+ */
+typedef struct  {
+    uint32_t *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    uint32_t span;          /**< @brief Sequence wrap, multiple of size */
+    uint32_t windex;        /**< @brief Writer slot index */
+    uint32_t wseq;          /**< @brief Writer copy of sequence */
+    xIFO_ATOMIC(uint32_t) wrapped;  /**< @brief Sequence wrapped at least once */
+    xIFO_ATOMIC(uint32_t) seq;  /**< @brief Published sequence (generation) */
+}xifo32_bc_t;
+
+/**
+ * @brief   Broadcast reader cursor.
+ */
+typedef struct  {
+    uint32_t seq;           /**< @brief Sequence of next element to read */
+    uint32_t index;         /**< @brief Slot index of next element to read */
+    uint32_t lost;          /**< @brief Elements lost by being lapped */
+}xifo32_bc_reader_t;
+
+/* Broadcast use */
+void xifo32_bc_init( xifo32_bc_t *c, uint32_t size, uint32_t *startpool );
+void xifo32_bc_write( xifo32_bc_t *c, uint32_t data );
+void xifo32_bc_reader_init( xifo32_bc_t *c, xifo32_bc_reader_t *r );
+uint32_t xifo32_bc_read_lr( xifo32_bc_t *c, xifo32_bc_reader_t *r, uint32_t *data );
+uint32_t xifo32_bc_get_used( xifo32_bc_t *c, xifo32_bc_reader_t *r );
+uint32_t xifo32_bc_get_lost( xifo32_bc_reader_t *r );
+uint32_t xifo32_bc_snapshot_mr( xifo32_bc_t *c, uint32_t *dst, uint32_t n );
+#endif
+
+/**
+ * @brief   Priority set of up to 32 circular buffers.
+ * @details Level 0 is the highest priority. A bitmap of non-empty levels
+ *          makes write and pop O(1), independent of the number of levels.
+ *          An optional quota limits how many elements a level may pop in
+ *          a row while a lower level is waiting.
+ * @note    At most 32 levels, one bit each. xifo32_prio_init clamps a
+ *          larger count to 32, writes to the levels above fail.
+ */
+typedef struct  {
+    xifo32_t *level;        /**< @brief Buffer per level */
+    const uint32_t *quota;  /**< @brief Pops in a row per level, 0 is no limit (optional) */
+    uint32_t levels;        /**< @brief Number of levels */
+    uint32_t nonempty;      /**< @brief Bit (31 - level) set when level has data */
+    uint32_t exhausted;     /**< @brief Bit (31 - level) set when quota is used up */
+    uint32_t runlevel;      /**< @brief Level of the last pop */
+    uint32_t run;           /**< @brief Pops in a row from runlevel */
+}xifo32_prio_t;
+
+/* Priority use */
+void xifo32_prio_init( xifo32_prio_t *c, uint32_t levels, xifo32_t *level, const uint32_t *quota );
+uint32_t xifo32_prio_write( xifo32_prio_t *c, uint32_t prio, uint32_t data );
+uint32_t xifo32_prio_pop( xifo32_prio_t *c );
+uint32_t xifo32_prio_get_level( xifo32_prio_t *c );
+
+/**
+ * @brief   Power of two circular buffer object.
+ * @details Free running head index wrapped with a mask, no end of pool
+ *          compare on read, write or pop. Same semantics as xifo32_t.
+ */
+typedef struct  {
+    uint32_t *startpool;    /**< @brief First element in pool */
+    uint32_t mask;          /**< @brief Size of buffer - 1 */
+    uint32_t head;          /**< @brief Free running write index */
+    uint32_t count;         /**< @brief Number of elements used */
+}xifo32_p2_t;
+
+/* Power of two use */
+void xifo32_p2_init( xifo32_p2_t *c, uint32_t size, uint32_t *startpool );
+void xifo32_p2_clear( xifo32_p2_t *c );
+uint32_t xifo32_p2_write( xifo32_p2_t *c, uint32_t data );
+uint32_t xifo32_p2_read_lr( xifo32_p2_t *c, uint32_t index );
+uint32_t xifo32_p2_read_mr( xifo32_p2_t *c, uint32_t index );
+uint32_t xifo32_p2_pop_lr( xifo32_p2_t *c );
+uint32_t xifo32_p2_pop_mr( xifo32_p2_t *c );
+uint32_t xifo32_p2_get_size( xifo32_p2_t *c );
+uint32_t xifo32_p2_get_used( xifo32_p2_t *c );
+uint32_t xifo32_p2_get_full( xifo32_p2_t *c );
+uint32_t xifo32_p2_get_free( xifo32_p2_t *c );
+
+/**
+ * @brief   Compact circular buffer object, at most 65535 elements.
+ * @details Base pointer and 16 bit indices, 16 bytes on 64 bit hosts
+ *          instead of the 48 of xifo32_t. Same semantics as xifo32_t,
+ *          full and the end of pool are derived.
+ */
+typedef struct  {
+    uint32_t *startpool;    /**< @brief First element in pool */
+    uint16_t size;          /**< @brief Size of buffer */
+    uint16_t head;          /**< @brief Index of next write */
+    uint16_t count;         /**< @brief Number of elements used */
+}xifo32_compact_t;
+
+/* Compact use */
+void xifo32_compact_init( xifo32_compact_t *c, uint32_t size, uint32_t *startpool );
+void xifo32_compact_clear( xifo32_compact_t *c );
+uint32_t xifo32_compact_write( xifo32_compact_t *c, uint32_t data );
+uint32_t xifo32_compact_read_lr( xifo32_compact_t *c, uint32_t index );
+uint32_t xifo32_compact_read_mr( xifo32_compact_t *c, uint32_t index );
+uint32_t xifo32_compact_pop_lr( xifo32_compact_t *c );
+uint32_t xifo32_compact_pop_mr( xifo32_compact_t *c );
+uint32_t xifo32_compact_get_size( xifo32_compact_t *c );
+uint32_t xifo32_compact_get_used( xifo32_compact_t *c );
+uint32_t xifo32_compact_get_full( xifo32_compact_t *c );
+uint32_t xifo32_compact_get_free( xifo32_compact_t *c );
+
+
 #endif
 
 #if xIFO_USE_16BIT == TRUE
@@ -485,6 +2853,171 @@ uint32_t xifo16_get_size( xifo16_t *c);
 uint32_t xifo16_get_used( xifo16_t *c);
 uint32_t xifo16_get_full( xifo16_t *c);
 uint32_t xifo16_get_free( xifo16_t *c);
+/* Bulk use */
+uint32_t xifo16_write_n( xifo16_t *c, const uint16_t *data, uint32_t n );
+uint32_t xifo16_pop_lr_n( xifo16_t *c, uint16_t *dst, uint32_t n );
+uint32_t xifo16_read_lr_n( xifo16_t *c, uint16_t *dst, uint32_t index, uint32_t n );
+/* Zero-copy use */
+void xifo16_peek_contiguous( xifo16_t *c, const uint16_t **ptr, uint32_t *len );
+void xifo16_peek_segments( xifo16_t *c, const uint16_t **ptr1, uint32_t *len1, const uint16_t **ptr2, uint32_t *len2 );
+uint32_t xifo16_consume( xifo16_t *c, uint32_t n );
+/* Visitor use */
+uint32_t xifo16_for_each_lr( xifo16_t *c, void (*fn)( uint16_t data, void *ctx ), void *ctx );
+uint32_t xifo16_drain_lr( xifo16_t *c, void (*fn)( uint16_t data, void *ctx ), void *ctx );
+
+/**
+ * @brief   External producer, the write position comes from outside the CPU.
+ * @details For circular DMA: the hardware fills the pool of a xifo16_t, the
+ *          CPU consumes it with the normal calls after xifo16_ext_sync.
+ * @note    A DMA pool in cached memory needs cache maintenance before the
+ *          sync, a producer thread publishes reg with a release store.
+ */
+typedef struct  {
+    xifo16_t *fifo;         /**< @brief Buffer the producer writes to */
+    const volatile uint32_t *reg;   /**< @brief Producer position */
+    uint32_t remaining;     /**< @brief reg counts down the remaining elements */
+    uint32_t lost;          /**< @brief Elements overwritten before they were consumed */
+}xifo16_ext_t;
+
+/* External producer use */
+void xifo16_ext_init( xifo16_ext_t *e, xifo16_t *c, const volatile uint32_t *reg, uint32_t remaining );
+uint32_t xifo16_ext_sync( xifo16_ext_t *e );
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Lock-free single producer, single consumer circular buffer object.
+ * @details The producer owns @p write, the consumer owns @p read.
+ *          Both positions run from 0 to 2*size so no shared count is needed,
+ *          each side lives on its own cache line.
+ */
+typedef struct  {
+    /* Shared, constant after init: */
+    uint16_t *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    /* Producer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) write;    /**< @brief Write position */
+    uint32_t rcache;        /**< @brief Producer copy of read position */
+    uint32_t reserved;      /**< @brief Reserved, not yet committed slots */
+    xIFO_ATOMIC(uint32_t) rwait;    /**< @brief Consumer is sleeping */
+    int rfd;                /**< @brief eventfd signalled on empty to non-empty, -1 if unused */
+    /* Consumer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) read;     /**< @brief Read position */
+    uint32_t wcache;        /**< @brief Consumer copy of write position */
+    uint32_t peeked;        /**< @brief Peeked, not yet released elements */
+    xIFO_ATOMIC(uint32_t) wwait;    /**< @brief Producer is sleeping */
+    int wfd;                /**< @brief eventfd signalled on full to non-full, -1 if unused */
+}xifo16_spsc_t;
+
+/* SPSC use */
+void xifo16_spsc_init( xifo16_spsc_t *c, uint32_t size, uint16_t *startpool );
+uint32_t xifo16_spsc_write( xifo16_spsc_t *c, uint16_t data );
+uint32_t xifo16_spsc_pop_lr( xifo16_spsc_t *c, uint16_t *data );
+uint16_t xifo16_spsc_read_lr( xifo16_spsc_t *c, uint32_t index );
+uint32_t xifo16_spsc_reserve( xifo16_spsc_t *c, uint16_t **ptr, uint32_t n );
+void xifo16_spsc_commit( xifo16_spsc_t *c, uint32_t n );
+uint32_t xifo16_spsc_peek( xifo16_spsc_t *c, const uint16_t **ptr, uint32_t n );
+void xifo16_spsc_release( xifo16_spsc_t *c, uint32_t n );
+uint32_t xifo16_spsc_get_size( xifo16_spsc_t *c );
+uint32_t xifo16_spsc_get_used( xifo16_spsc_t *c );
+uint32_t xifo16_spsc_get_full( xifo16_spsc_t *c );
+uint32_t xifo16_spsc_get_free( xifo16_spsc_t *c );
+#if xIFO_USE_LINUX == TRUE
+uint32_t xifo16_spsc_write_wait( xifo16_spsc_t *c, uint16_t data, uint32_t timeout );
+uint32_t xifo16_spsc_pop_lr_wait( xifo16_spsc_t *c, uint16_t *data, uint32_t timeout );
+void xifo16_spsc_set_eventfd( xifo16_spsc_t *c, int readable, int writable );
+#endif
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Single writer, multi reader broadcast circular buffer object.
+ * @details Written once, every reader has its own cursor. The writer
+ *          never waits, readers that are lapped skip ahead and count the
+ *          elements they lost.
+ */
+typedef struct  {
+    uint16_t *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    uint32_t span;          /**< @brief Sequence wrap, multiple of size */
+    uint32_t windex;        /**< @brief Writer slot index */
+    uint32_t wseq;          /**< @brief Writer copy of sequence */
+    xIFO_ATOMIC(uint32_t) wrapped;  /**< @brief Sequence wrapped at least once */
+    xIFO_ATOMIC(uint32_t) seq;  /**< @brief Published sequence (generation) */
+}xifo16_bc_t;
+
+/**
+ * @brief   Broadcast reader cursor.
+ */
+typedef struct  {
+    uint32_t seq;           /**< @brief Sequence of next element to read */
+    uint32_t index;         /**< @brief Slot index of next element to read */
+    uint32_t lost;          /**< @brief Elements lost by being lapped */
+}xifo16_bc_reader_t;
+
+/* Broadcast use */
+void xifo16_bc_init( xifo16_bc_t *c, uint32_t size, uint16_t *startpool );
+void xifo16_bc_write( xifo16_bc_t *c, uint16_t data );
+void xifo16_bc_reader_init( xifo16_bc_t *c, xifo16_bc_reader_t *r );
+uint32_t xifo16_bc_read_lr( xifo16_bc_t *c, xifo16_bc_reader_t *r, uint16_t *data );
+uint32_t xifo16_bc_get_used( xifo16_bc_t *c, xifo16_bc_reader_t *r );
+uint32_t xifo16_bc_get_lost( xifo16_bc_reader_t *r );
+uint32_t xifo16_bc_snapshot_mr( xifo16_bc_t *c, uint16_t *dst, uint32_t n );
+#endif
+
+/**
+ * @brief   Power of two circular buffer object.
+ * @details Free running head index wrapped with a mask, no end of pool
+ *          compare on read, write or pop. Same semantics as xifo16_t.
+ */
+typedef struct  {
+    uint16_t *startpool;    /**< @brief First element in pool */
+    uint32_t mask;          /**< @brief Size of buffer - 1 */
+    uint32_t head;          /**< @brief Free running write index */
+    uint32_t count;         /**< @brief Number of elements used */
+}xifo16_p2_t;
+
+/* Power of two use */
+void xifo16_p2_init( xifo16_p2_t *c, uint32_t size, uint16_t *startpool );
+void xifo16_p2_clear( xifo16_p2_t *c );
+uint32_t xifo16_p2_write( xifo16_p2_t *c, uint16_t data );
+uint16_t xifo16_p2_read_lr( xifo16_p2_t *c, uint32_t index );
+uint16_t xifo16_p2_read_mr( xifo16_p2_t *c, uint32_t index );
+uint16_t xifo16_p2_pop_lr( xifo16_p2_t *c );
+uint16_t xifo16_p2_pop_mr( xifo16_p2_t *c );
+uint32_t xifo16_p2_get_size( xifo16_p2_t *c );
+uint32_t xifo16_p2_get_used( xifo16_p2_t *c );
+uint32_t xifo16_p2_get_full( xifo16_p2_t *c );
+uint32_t xifo16_p2_get_free( xifo16_p2_t *c );
+
+/**
+ * @brief   Compact circular buffer object, at most 65535 elements.
+ * @details Base pointer and 16 bit indices, 16 bytes on 64 bit hosts
+ *          instead of the 48 of xifo16_t. Same semantics as xifo16_t,
+ *          full and the end of pool are derived.
+ */
+typedef struct  {
+    uint16_t *startpool;    /**< @brief First element in pool */
+    uint16_t size;          /**< @brief Size of buffer */
+    uint16_t head;          /**< @brief Index of next write */
+    uint16_t count;         /**< @brief Number of elements used */
+}xifo16_compact_t;
+
+/* Compact use */
+void xifo16_compact_init( xifo16_compact_t *c, uint32_t size, uint16_t *startpool );
+void xifo16_compact_clear( xifo16_compact_t *c );
+uint32_t xifo16_compact_write( xifo16_compact_t *c, uint16_t data );
+uint16_t xifo16_compact_read_lr( xifo16_compact_t *c, uint32_t index );
+uint16_t xifo16_compact_read_mr( xifo16_compact_t *c, uint32_t index );
+uint16_t xifo16_compact_pop_lr( xifo16_compact_t *c );
+uint16_t xifo16_compact_pop_mr( xifo16_compact_t *c );
+uint32_t xifo16_compact_get_size( xifo16_compact_t *c );
+uint32_t xifo16_compact_get_used( xifo16_compact_t *c );
+uint32_t xifo16_compact_get_full( xifo16_compact_t *c );
+uint32_t xifo16_compact_get_free( xifo16_compact_t *c );
+
+
 #endif
 
 #if xIFO_USE_8BIT == TRUE
@@ -522,6 +3055,217 @@ uint32_t xifo8_get_size( xifo8_t *c );
 uint32_t xifo8_get_used( xifo8_t *c );
 uint32_t xifo8_get_full( xifo8_t *c );
 uint32_t xifo8_get_free( xifo8_t *c );
+/* Bulk use */
+uint32_t xifo8_write_n( xifo8_t *c, const uint8_t *data, uint32_t n );
+uint32_t xifo8_pop_lr_n( xifo8_t *c, uint8_t *dst, uint32_t n );
+uint32_t xifo8_read_lr_n( xifo8_t *c, uint8_t *dst, uint32_t index, uint32_t n );
+/* Zero-copy use */
+void xifo8_peek_contiguous( xifo8_t *c, const uint8_t **ptr, uint32_t *len );
+void xifo8_peek_segments( xifo8_t *c, const uint8_t **ptr1, uint32_t *len1, const uint8_t **ptr2, uint32_t *len2 );
+uint32_t xifo8_consume( xifo8_t *c, uint32_t n );
+/* Visitor use */
+uint32_t xifo8_for_each_lr( xifo8_t *c, void (*fn)( uint8_t data, void *ctx ), void *ctx );
+uint32_t xifo8_drain_lr( xifo8_t *c, void (*fn)( uint8_t data, void *ctx ), void *ctx );
+#if xIFO_USE_LINUX == TRUE
+/* File descriptor use */
+int32_t xifo8_fill_from_fd( xifo8_t *c, int fd );
+int32_t xifo8_drain_to_fd( xifo8_t *c, int fd );
+#endif
+
+/**
+ * @brief   External producer, the write position comes from outside the CPU.
+ * @details For circular DMA: the hardware fills the pool of a xifo8_t, the
+ *          CPU consumes it with the normal calls after xifo8_ext_sync.
+ * @note    A DMA pool in cached memory needs cache maintenance before the
+ *          sync, a producer thread publishes reg with a release store.
+ */
+typedef struct  {
+    xifo8_t *fifo;         /**< @brief Buffer the producer writes to */
+    const volatile uint32_t *reg;   /**< @brief Producer position */
+    uint32_t remaining;     /**< @brief reg counts down the remaining elements */
+    uint32_t lost;          /**< @brief Elements overwritten before they were consumed */
+}xifo8_ext_t;
+
+/* External producer use */
+void xifo8_ext_init( xifo8_ext_t *e, xifo8_t *c, const volatile uint32_t *reg, uint32_t remaining );
+uint32_t xifo8_ext_sync( xifo8_ext_t *e );
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Lock-free single producer, single consumer circular buffer object.
+ * @details The producer owns @p write, the consumer owns @p read.
+ *          Both positions run from 0 to 2*size so no shared count is needed,
+ *          each side lives on its own cache line.
+ */
+typedef struct  {
+    /* Shared, constant after init: */
+    uint8_t *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    /* Producer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) write;    /**< @brief Write position */
+    uint32_t rcache;        /**< @brief Producer copy of read position */
+    uint32_t reserved;      /**< @brief Reserved, not yet committed slots */
+    xIFO_ATOMIC(uint32_t) rwait;    /**< @brief Consumer is sleeping */
+    int rfd;                /**< @brief eventfd signalled on empty to non-empty, -1 if unused */
+    /* Consumer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) read;     /**< @brief Read position */
+    uint32_t wcache;        /**< @brief Consumer copy of write position */
+    uint32_t peeked;        /**< @brief Peeked, not yet released elements */
+    xIFO_ATOMIC(uint32_t) wwait;    /**< @brief Producer is sleeping */
+    int wfd;                /**< @brief eventfd signalled on full to non-full, -1 if unused */
+}xifo8_spsc_t;
+
+/* SPSC use */
+void xifo8_spsc_init( xifo8_spsc_t *c, uint32_t size, uint8_t *startpool );
+uint32_t xifo8_spsc_write( xifo8_spsc_t *c, uint8_t data );
+uint32_t xifo8_spsc_pop_lr( xifo8_spsc_t *c, uint8_t *data );
+uint8_t xifo8_spsc_read_lr( xifo8_spsc_t *c, uint32_t index );
+uint32_t xifo8_spsc_reserve( xifo8_spsc_t *c, uint8_t **ptr, uint32_t n );
+void xifo8_spsc_commit( xifo8_spsc_t *c, uint32_t n );
+uint32_t xifo8_spsc_peek( xifo8_spsc_t *c, const uint8_t **ptr, uint32_t n );
+void xifo8_spsc_release( xifo8_spsc_t *c, uint32_t n );
+uint32_t xifo8_spsc_get_size( xifo8_spsc_t *c );
+uint32_t xifo8_spsc_get_used( xifo8_spsc_t *c );
+uint32_t xifo8_spsc_get_full( xifo8_spsc_t *c );
+uint32_t xifo8_spsc_get_free( xifo8_spsc_t *c );
+#if xIFO_USE_LINUX == TRUE
+uint32_t xifo8_spsc_write_wait( xifo8_spsc_t *c, uint8_t data, uint32_t timeout );
+uint32_t xifo8_spsc_pop_lr_wait( xifo8_spsc_t *c, uint8_t *data, uint32_t timeout );
+void xifo8_spsc_set_eventfd( xifo8_spsc_t *c, int readable, int writable );
+#endif
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Single writer, multi reader broadcast circular buffer object.
+ * @details Written once, every reader has its own cursor. The writer
+ *          never waits, readers that are lapped skip ahead and count the
+ *          elements they lost.
+ */
+typedef struct  {
+    uint8_t *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    uint32_t span;          /**< @brief Sequence wrap, multiple of size */
+    uint32_t windex;        /**< @brief Writer slot index */
+    uint32_t wseq;          /**< @brief Writer copy of sequence */
+    xIFO_ATOMIC(uint32_t) wrapped;  /**< @brief Sequence wrapped at least once */
+    xIFO_ATOMIC(uint32_t) seq;  /**< @brief Published sequence (generation) */
+}xifo8_bc_t;
+
+/**
+ * @brief   Broadcast reader cursor.
+ */
+typedef struct  {
+    uint32_t seq;           /**< @brief Sequence of next element to read */
+    uint32_t index;         /**< @brief Slot index of next element to read */
+    uint32_t lost;          /**< @brief Elements lost by being lapped */
+}xifo8_bc_reader_t;
+
+/* Broadcast use */
+void xifo8_bc_init( xifo8_bc_t *c, uint32_t size, uint8_t *startpool );
+void xifo8_bc_write( xifo8_bc_t *c, uint8_t data );
+void xifo8_bc_reader_init( xifo8_bc_t *c, xifo8_bc_reader_t *r );
+uint32_t xifo8_bc_read_lr( xifo8_bc_t *c, xifo8_bc_reader_t *r, uint8_t *data );
+uint32_t xifo8_bc_get_used( xifo8_bc_t *c, xifo8_bc_reader_t *r );
+uint32_t xifo8_bc_get_lost( xifo8_bc_reader_t *r );
+uint32_t xifo8_bc_snapshot_mr( xifo8_bc_t *c, uint8_t *dst, uint32_t n );
+#endif
+
+/**
+ * @brief   Bip buffer object, variable sized contiguous blocks.
+ * @details Data lives in region A and, once the end of the pool is reached,
+ *          in region B at the start of the pool. A block that does not fit
+ *          before the end wraps early instead of being split.
+ */
+typedef struct  {
+    uint8_t *startpool;     /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    uint32_t astart;        /**< @brief Start of region A, least recent data */
+    uint32_t aend;          /**< @brief End of region A */
+    uint32_t bend;          /**< @brief End of region B, starts at 0 */
+    uint32_t bactive;       /**< @brief Region B holds data */
+    uint32_t rstart;        /**< @brief Start of reservation */
+    uint32_t rlen;          /**< @brief Length of reservation */
+}xifo8_bip_t;
+
+/* Bip buffer use */
+void xifo8_bip_init( xifo8_bip_t *c, uint32_t size, uint8_t *startpool );
+uint8_t *xifo8_bip_reserve( xifo8_bip_t *c, uint32_t len );
+void xifo8_bip_commit( xifo8_bip_t *c, uint32_t len );
+const uint8_t *xifo8_bip_peek( xifo8_bip_t *c, uint32_t *len );
+void xifo8_bip_release( xifo8_bip_t *c, uint32_t len );
+uint32_t xifo8_bip_get_size( xifo8_bip_t *c );
+uint32_t xifo8_bip_get_used( xifo8_bip_t *c );
+
+/**
+ * @brief   Message ring, variable length records stored inline.
+ * @details Every message is one Bip buffer block: a length header of 1 to
+ *          5 bytes (7 bits per byte, least significant first) followed by
+ *          the message itself, so a message is always contiguous.
+ */
+typedef xifo8_bip_t xifo8_msg_t;
+
+/* Message use */
+void xifo8_msg_init( xifo8_msg_t *c, uint32_t size, uint8_t *startpool );
+uint32_t xifo8_push_msg( xifo8_msg_t *c, const void *msg, uint32_t len );
+const uint8_t *xifo8_front_msg( xifo8_msg_t *c, uint32_t *len );
+uint32_t xifo8_pop_msg( xifo8_msg_t *c );
+uint32_t xifo8_for_each_msg( xifo8_msg_t *c, void (*fn)( const uint8_t *msg, uint32_t len, void *arg ), void *arg );
+
+/**
+ * @brief   Power of two circular buffer object.
+ * @details Free running head index wrapped with a mask, no end of pool
+ *          compare on read, write or pop. Same semantics as xifo8_t.
+ */
+typedef struct  {
+    uint8_t *startpool;    /**< @brief First element in pool */
+    uint32_t mask;          /**< @brief Size of buffer - 1 */
+    uint32_t head;          /**< @brief Free running write index */
+    uint32_t count;         /**< @brief Number of elements used */
+}xifo8_p2_t;
+
+/* Power of two use */
+void xifo8_p2_init( xifo8_p2_t *c, uint32_t size, uint8_t *startpool );
+void xifo8_p2_clear( xifo8_p2_t *c );
+uint32_t xifo8_p2_write( xifo8_p2_t *c, uint8_t data );
+uint8_t xifo8_p2_read_lr( xifo8_p2_t *c, uint32_t index );
+uint8_t xifo8_p2_read_mr( xifo8_p2_t *c, uint32_t index );
+uint8_t xifo8_p2_pop_lr( xifo8_p2_t *c );
+uint8_t xifo8_p2_pop_mr( xifo8_p2_t *c );
+uint32_t xifo8_p2_get_size( xifo8_p2_t *c );
+uint32_t xifo8_p2_get_used( xifo8_p2_t *c );
+uint32_t xifo8_p2_get_full( xifo8_p2_t *c );
+uint32_t xifo8_p2_get_free( xifo8_p2_t *c );
+
+/**
+ * @brief   Compact circular buffer object, at most 65535 elements.
+ * @details Base pointer and 16 bit indices, 16 bytes on 64 bit hosts
+ *          instead of the 48 of xifo8_t. Same semantics as xifo8_t,
+ *          full and the end of pool are derived.
+ */
+typedef struct  {
+    uint8_t *startpool;    /**< @brief First element in pool */
+    uint16_t size;          /**< @brief Size of buffer */
+    uint16_t head;          /**< @brief Index of next write */
+    uint16_t count;         /**< @brief Number of elements used */
+}xifo8_compact_t;
+
+/* Compact use */
+void xifo8_compact_init( xifo8_compact_t *c, uint32_t size, uint8_t *startpool );
+void xifo8_compact_clear( xifo8_compact_t *c );
+uint32_t xifo8_compact_write( xifo8_compact_t *c, uint8_t data );
+uint8_t xifo8_compact_read_lr( xifo8_compact_t *c, uint32_t index );
+uint8_t xifo8_compact_read_mr( xifo8_compact_t *c, uint32_t index );
+uint8_t xifo8_compact_pop_lr( xifo8_compact_t *c );
+uint8_t xifo8_compact_pop_mr( xifo8_compact_t *c );
+uint32_t xifo8_compact_get_size( xifo8_compact_t *c );
+uint32_t xifo8_compact_get_used( xifo8_compact_t *c );
+uint32_t xifo8_compact_get_full( xifo8_compact_t *c );
+uint32_t xifo8_compact_get_free( xifo8_compact_t *c );
+
+
 #endif
 
 #if xIFO_USE_32FLOAT == TRUE
@@ -559,6 +3303,153 @@ uint32_t xifo32f_get_size( xifo32f_t *c );
 uint32_t xifo32f_get_used( xifo32f_t *c );
 uint32_t xifo32f_get_full( xifo32f_t *c );
 uint32_t xifo32f_get_free( xifo32f_t *c );
+/* Bulk use */
+uint32_t xifo32f_write_n( xifo32f_t *c, const float *data, uint32_t n );
+uint32_t xifo32f_pop_lr_n( xifo32f_t *c, float *dst, uint32_t n );
+uint32_t xifo32f_read_lr_n( xifo32f_t *c, float *dst, uint32_t index, uint32_t n );
+/* Zero-copy use */
+void xifo32f_peek_contiguous( xifo32f_t *c, const float **ptr, uint32_t *len );
+void xifo32f_peek_segments( xifo32f_t *c, const float **ptr1, uint32_t *len1, const float **ptr2, uint32_t *len2 );
+uint32_t xifo32f_consume( xifo32f_t *c, uint32_t n );
+/* Visitor use */
+uint32_t xifo32f_for_each_lr( xifo32f_t *c, void (*fn)( float data, void *ctx ), void *ctx );
+uint32_t xifo32f_drain_lr( xifo32f_t *c, void (*fn)( float data, void *ctx ), void *ctx );
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Lock-free single producer, single consumer circular buffer object.
+ * @details The producer owns @p write, the consumer owns @p read.
+ *          Both positions run from 0 to 2*size so no shared count is needed,
+ *          each side lives on its own cache line.
+ */
+typedef struct  {
+    /* Shared, constant after init: */
+    float *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    /* Producer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) write;    /**< @brief Write position */
+    uint32_t rcache;        /**< @brief Producer copy of read position */
+    uint32_t reserved;      /**< @brief Reserved, not yet committed slots */
+    xIFO_ATOMIC(uint32_t) rwait;    /**< @brief Consumer is sleeping */
+    int rfd;                /**< @brief eventfd signalled on empty to non-empty, -1 if unused */
+    /* Consumer: */
+    xIFO_ALIGNED(xIFO_CACHE_LINE)
+    xIFO_ATOMIC(uint32_t) read;     /**< @brief Read position */
+    uint32_t wcache;        /**< @brief Consumer copy of write position */
+    uint32_t peeked;        /**< @brief Peeked, not yet released elements */
+    xIFO_ATOMIC(uint32_t) wwait;    /**< @brief Producer is sleeping */
+    int wfd;                /**< @brief eventfd signalled on full to non-full, -1 if unused */
+}xifo32f_spsc_t;
+
+/* SPSC use */
+void xifo32f_spsc_init( xifo32f_spsc_t *c, uint32_t size, float *startpool );
+uint32_t xifo32f_spsc_write( xifo32f_spsc_t *c, float data );
+uint32_t xifo32f_spsc_pop_lr( xifo32f_spsc_t *c, float *data );
+float xifo32f_spsc_read_lr( xifo32f_spsc_t *c, uint32_t index );
+uint32_t xifo32f_spsc_reserve( xifo32f_spsc_t *c, float **ptr, uint32_t n );
+void xifo32f_spsc_commit( xifo32f_spsc_t *c, uint32_t n );
+uint32_t xifo32f_spsc_peek( xifo32f_spsc_t *c, const float **ptr, uint32_t n );
+void xifo32f_spsc_release( xifo32f_spsc_t *c, uint32_t n );
+uint32_t xifo32f_spsc_get_size( xifo32f_spsc_t *c );
+uint32_t xifo32f_spsc_get_used( xifo32f_spsc_t *c );
+uint32_t xifo32f_spsc_get_full( xifo32f_spsc_t *c );
+uint32_t xifo32f_spsc_get_free( xifo32f_spsc_t *c );
+#if xIFO_USE_LINUX == TRUE
+uint32_t xifo32f_spsc_write_wait( xifo32f_spsc_t *c, float data, uint32_t timeout );
+uint32_t xifo32f_spsc_pop_lr_wait( xifo32f_spsc_t *c, float *data, uint32_t timeout );
+void xifo32f_spsc_set_eventfd( xifo32f_spsc_t *c, int readable, int writable );
+#endif
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/**
+ * @brief   Single writer, multi reader broadcast circular buffer object.
+ * @details Written once, every reader has its own cursor. The writer
+ *          never waits, readers that are lapped skip ahead and count the
+ *          elements they lost.
+ */
+typedef struct  {
+    float *startpool;    /**< @brief First element in pool */
+    uint32_t size;          /**< @brief Size of buffer */
+    uint32_t span;          /**< @brief Sequence wrap, multiple of size */
+    uint32_t windex;        /**< @brief Writer slot index */
+    uint32_t wseq;          /**< @brief Writer copy of sequence */
+    xIFO_ATOMIC(uint32_t) wrapped;  /**< @brief Sequence wrapped at least once */
+    xIFO_ATOMIC(uint32_t) seq;  /**< @brief Published sequence (generation) */
+}xifo32f_bc_t;
+
+/**
+ * @brief   Broadcast reader cursor.
+ */
+typedef struct  {
+    uint32_t seq;           /**< @brief Sequence of next element to read */
+    uint32_t index;         /**< @brief Slot index of next element to read */
+    uint32_t lost;          /**< @brief Elements lost by being lapped */
+}xifo32f_bc_reader_t;
+
+/* Broadcast use */
+void xifo32f_bc_init( xifo32f_bc_t *c, uint32_t size, float *startpool );
+void xifo32f_bc_write( xifo32f_bc_t *c, float data );
+void xifo32f_bc_reader_init( xifo32f_bc_t *c, xifo32f_bc_reader_t *r );
+uint32_t xifo32f_bc_read_lr( xifo32f_bc_t *c, xifo32f_bc_reader_t *r, float *data );
+uint32_t xifo32f_bc_get_used( xifo32f_bc_t *c, xifo32f_bc_reader_t *r );
+uint32_t xifo32f_bc_get_lost( xifo32f_bc_reader_t *r );
+uint32_t xifo32f_bc_snapshot_mr( xifo32f_bc_t *c, float *dst, uint32_t n );
+#endif
+
+/**
+ * @brief   Power of two circular buffer object.
+ * @details Free running head index wrapped with a mask, no end of pool
+ *          compare on read, write or pop. Same semantics as xifo32f_t.
+ */
+typedef struct  {
+    float *startpool;    /**< @brief First element in pool */
+    uint32_t mask;          /**< @brief Size of buffer - 1 */
+    uint32_t head;          /**< @brief Free running write index */
+    uint32_t count;         /**< @brief Number of elements used */
+}xifo32f_p2_t;
+
+/* Power of two use */
+void xifo32f_p2_init( xifo32f_p2_t *c, uint32_t size, float *startpool );
+void xifo32f_p2_clear( xifo32f_p2_t *c );
+uint32_t xifo32f_p2_write( xifo32f_p2_t *c, float data );
+float xifo32f_p2_read_lr( xifo32f_p2_t *c, uint32_t index );
+float xifo32f_p2_read_mr( xifo32f_p2_t *c, uint32_t index );
+float xifo32f_p2_pop_lr( xifo32f_p2_t *c );
+float xifo32f_p2_pop_mr( xifo32f_p2_t *c );
+uint32_t xifo32f_p2_get_size( xifo32f_p2_t *c );
+uint32_t xifo32f_p2_get_used( xifo32f_p2_t *c );
+uint32_t xifo32f_p2_get_full( xifo32f_p2_t *c );
+uint32_t xifo32f_p2_get_free( xifo32f_p2_t *c );
+
+/**
+ * @brief   Compact circular buffer object, at most 65535 elements.
+ * @details Base pointer and 16 bit indices, 16 bytes on 64 bit hosts
+ *          instead of the 48 of xifo32f_t. Same semantics as xifo32f_t,
+ *          full and the end of pool are derived.
+ */
+typedef struct  {
+    float *startpool;    /**< @brief First element in pool */
+    uint16_t size;          /**< @brief Size of buffer */
+    uint16_t head;          /**< @brief Index of next write */
+    uint16_t count;         /**< @brief Number of elements used */
+}xifo32f_compact_t;
+
+/* Compact use */
+void xifo32f_compact_init( xifo32f_compact_t *c, uint32_t size, float *startpool );
+void xifo32f_compact_clear( xifo32f_compact_t *c );
+uint32_t xifo32f_compact_write( xifo32f_compact_t *c, float data );
+float xifo32f_compact_read_lr( xifo32f_compact_t *c, uint32_t index );
+float xifo32f_compact_read_mr( xifo32f_compact_t *c, uint32_t index );
+float xifo32f_compact_pop_lr( xifo32f_compact_t *c );
+float xifo32f_compact_pop_mr( xifo32f_compact_t *c );
+uint32_t xifo32f_compact_get_size( xifo32f_compact_t *c );
+uint32_t xifo32f_compact_get_used( xifo32f_compact_t *c );
+uint32_t xifo32f_compact_get_full( xifo32f_compact_t *c );
+uint32_t xifo32f_compact_get_free( xifo32f_compact_t *c );
+
+
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,519 @@
+/**
+ * @file    xifo.c
+ * @brief   xifo circular buffer with runtime element size
+ * @details Generic xifo_t for elements that do not fit the 8/16/32/64 bit
+ *          types, such as small structs. Common element sizes get their
+ *          own unrolled copy routine.
+ *
+ * @Author	Jeroen Lodder
+ * @Date	March 2014
+ * @version 3
+ * 
+ * Copyright (c) 2014 Jeroen Lodder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @{
+ */
+#include <string.h>
+#include "xifo.h"
+
+#if xIFO_USE_GENERIC == TRUE
+/*
+ * Copy routines, picked by xifo_init. Fixed size memcpy compiles to plain
+ * loads and stores without a library call or alignment requirements.
+ */
+static void xifo_copy1(void *dst, const void *src, uint32_t esize){
+    (void)esize;
+    *(uint8_t *)dst = *(const uint8_t *)src;
+}
+
+static void xifo_copy2(void *dst, const void *src, uint32_t esize){
+    (void)esize;
+    memcpy(dst, src, 2);
+}
+
+static void xifo_copy4(void *dst, const void *src, uint32_t esize){
+    (void)esize;
+    memcpy(dst, src, 4);
+}
+
+static void xifo_copy8(void *dst, const void *src, uint32_t esize){
+    (void)esize;
+    memcpy(dst, src, 8);
+}
+
+static void xifo_copy16(void *dst, const void *src, uint32_t esize){
+    (void)esize;
+    memcpy(dst, src, 8);
+    memcpy((uint8_t *)dst + 8, (const uint8_t *)src + 8, 8);
+}
+
+static void xifo_copy32(void *dst, const void *src, uint32_t esize){
+    (void)esize;
+    memcpy(dst, src, 8);
+    memcpy((uint8_t *)dst + 8, (const uint8_t *)src + 8, 8);
+    memcpy((uint8_t *)dst + 16, (const uint8_t *)src + 16, 8);
+    memcpy((uint8_t *)dst + 24, (const uint8_t *)src + 24, 8);
+}
+
+static void xifo_copy64(void *dst, const void *src, uint32_t esize){
+    (void)esize;
+    xifo_copy32(dst, src, 32);
+    xifo_copy32((uint8_t *)dst + 32, (const uint8_t *)src + 32, 32);
+}
+
+static void xifo_copyn(void *dst, const void *src, uint32_t esize){
+    memcpy(dst, src, esize);
+}
+
+/**
+ * @brief   Element at index
+ */
+static inline uint8_t *xifo_element(xifo_t *c, uint32_t index){
+    return &c->startpool[index * c->esize];
+}
+
+/**
+ * @brief   Initialize buffer object structure.
+ *
+ * @note    Does not clear memory pool.
+ *
+ * @param[in] c   Pointer to @p xifo_t object used for configuration.
+ * @param[in] s   Number of elements buffer can hold (size).
+ * @param[in] e   Size of one element in bytes (esize).
+ * @param[in] sp  Start of pre-allocated memory pool of s * e bytes.
+ */
+void xifo_init(xifo_t *c, uint32_t s, uint32_t e, void *sp){
+    c->startpool		= (uint8_t *)sp;
+    c->esize			= e;
+    c->size 			= s;
+    c->full 			= 0;
+    c->count            = 0;
+    c->read 			= 0;
+    c->write			= 0;
+    switch(e){
+    case 1:  c->copy = xifo_copy1;  break;
+    case 2:  c->copy = xifo_copy2;  break;
+    case 4:  c->copy = xifo_copy4;  break;
+    case 8:  c->copy = xifo_copy8;  break;
+    case 16: c->copy = xifo_copy16; break;
+    case 32: c->copy = xifo_copy32; break;
+    case 64: c->copy = xifo_copy64; break;
+    default: c->copy = xifo_copyn;  break;
+    }
+}
+
+/**
+ * @brief   Clear buffer memory pool
+ *
+ * @note    Must be used on initialised buffer object.
+ *
+ * @param[in] c   Pointer to @p xifo_t object.
+ */
+void xifo_clear(xifo_t *c){
+    memset(c->startpool, 0, c->size * c->esize);
+}
+
+/**
+ * @brief   Write to buffer
+ *
+ * @note    Readpointer is automatically set to the last added element.
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @details Adds a value to the buffer.
+ *					Automatically overwrites oldest elements when full.
+ *
+ * @param[in] c			Pointer to @p xifo_t used for configuration.
+ * @param[in] data	Element to add to buffer (esize bytes)
+ *
+ * @return	Number of free buffer elements
+ */
+uint32_t xifo_write(xifo_t *c, const void *data){
+    /* Write data */
+    c->copy(xifo_element(c, c->write), data, c->esize);
+    /* Update read index to most recent element */
+    c->read = c->write;
+    /* Write index increment */
+    if(++c->write >= c->size){
+        c->write = 0;
+    }
+    /* Update count */
+    c->count++;
+    /* Verify full */
+    if( c->count >= c->size ){
+        c->full = 1;
+        c->count = c->size;
+    }
+    /* return free elements count */
+    return c->size - c->count;
+}
+
+/**
+ * @brief   Read from buffer (lr) Least Recent oriented (fifo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @details As for index[0] the least recently added element is returned.
+ *
+ * @param[in] c   		Pointer to @p xifo_t used for configuration.
+ * @param[in] index   Index relative from least recent
+ * @param[out] data   Contents of element (esize bytes)
+ *
+ * @return	1 if read, 0 if there is no element at index
+ */
+uint32_t xifo_read_lr(xifo_t *c, uint32_t index, void *data){
+    if(index >= c->count){
+        return 0;	/* Nothing to read there */
+    }
+    return xifo_read_mr(c, (c->count - 1) - index, data);
+}
+
+/**
+ * @brief   Pop (lr) least recent from buffer (fifo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @param[in] c	Pointer to @p xifo_t used for configuration.
+ * @param[out] data   Contents of element (esize bytes)
+ *
+ * @return	1 if popped, 0 if buffer was empty
+ */
+uint32_t xifo_pop_lr(xifo_t *c, void *data){
+    uint8_t *ptemp;
+    uint32_t index;
+    /* Verify there is valid data read */
+    if(c->count == 0){
+        return 0;	/* Nothing to read there */
+    }
+    /* Derive least recent buffer element */
+    index = c->read + c->size + 1 - c->count;
+    if(index >= c->size){
+        index -= c->size;
+    }
+    ptemp = xifo_element(c, index);
+    c->copy(data, ptemp, c->esize);
+    /* Empty buffer element */
+    memset(ptemp, 0, c->esize);
+    /* Reduce count */
+    c->count--;
+    /* Check full flag */
+    if(c->count < c->size)
+        c->full = 0;
+    return 1;
+}
+
+/**
+ * @brief   Read from buffer (mr) Most Recent oriented (filo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @details As for index[0] the most recently added element is returned.
+ *
+ * @param[in] c   		Pointer to @p xifo_t used for configuration.
+ * @param[in] index   Index relative from most recent
+ * @param[out] data   Contents of element (esize bytes)
+ *
+ * @return	1 if read, 0 if there is no element at index
+ */
+uint32_t xifo_read_mr(xifo_t *c, uint32_t index, void *data){
+    uint32_t i;
+    if(index >= c->count){
+        return 0;	/* Nothing to read there */
+    }
+    i = (c->read >= index) ? (c->read - index) : (c->read + c->size - index);
+    c->copy(data, xifo_element(c, i), c->esize);
+    return 1;
+}
+
+/**
+ * @brief   Pop (mr) most recent from buffer (filo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @param[in] c   		Pointer to @p xifo_t used for configuration.
+ * @param[out] data   Contents of element (esize bytes)
+ *
+ * @return	1 if popped, 0 if buffer was empty
+ */
+uint32_t xifo_pop_mr(xifo_t *c, void *data){
+    uint8_t *ptemp;
+    /* Verify there is valid data read */
+    if(c->count == 0){
+        return 0;	/* Nothing to read there */
+    }
+    ptemp = xifo_element(c, c->read);
+    c->copy(data, ptemp, c->esize);
+    /* Empty */
+    memset(ptemp, 0, c->esize);
+    /* Most recent element read, return write index */
+    c->write = c->read;
+    /* Decrement read index */
+    c->read = (c->read == 0) ? (c->size - 1) : (c->read - 1);
+    /* Reduce count */
+    c->count--;
+    if(c->count < c->size)
+        c->full = 0;
+    return 1;
+}
+
+/**
+ * @brief   Get buffer size
+ *
+ * @param[in] c	Pointer to @p xifo_t used for configuration.
+ *
+ * @return	Size of memory pool in elements
+ */
+uint32_t xifo_get_size(xifo_t *c){
+    return c->size;
+}
+
+/**
+ * @brief   Get number of used elements
+ *
+ * @param[in] c	Pointer to @p xifo_t used for configuration.
+ *
+ * @return	Number of used buffer elements
+ */
+uint32_t xifo_get_used(xifo_t *c){
+    return c->count;
+}
+
+/**
+* @brief   Get number of free elements
+*
+* @param[in] c	Pointer to @p xifo_t used for configuration.
+*
+* @return	Number of free elements
+*/
+uint32_t xifo_get_free(xifo_t *c){
+    return c->size - c->count;
+}
+
+/**
+ * @brief   Get full flag
+ *
+ * @param[in] c	Pointer to @p xifo_t used for configuration.
+ *
+ * @return	1 if full
+ */
+uint32_t xifo_get_full(xifo_t *c){
+    return c->full;
+}
+
+/**
+ * @brief   Get element size
+ *
+ * @param[in] c	Pointer to @p xifo_t used for configuration.
+ *
+ * @return	Size of one element in bytes
+ */
+uint32_t xifo_get_esize(xifo_t *c){
+    return c->esize;
+}
+
+/**
+ * @brief   Visit every element from least recent to most recent (fifo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @details Walks both pool segments in a plain loop, no wrap check per
+ *					element. fn gets a pointer into the pool and must not modify
+ *					the buffer.
+ *
+ * @param[in] c			Pointer to @p xifo_t used for configuration.
+ * @param[in] fn		Called with each element
+ * @param[in] ctx		Passed to fn
+ *
+ * @return	Number of elements visited
+ */
+uint32_t xifo_for_each_lr(xifo_t *c, void (*fn)(const void *data, void *ctx), void *ctx){
+    uint32_t r, first, i;
+    const uint8_t *p;
+    if(c->count == 0){
+        return 0;
+    }
+    r = c->read + c->size + 1 - c->count;
+    if(r >= c->size){
+        r -= c->size;
+    }
+    first = (c->count < c->size - r) ? c->count : (c->size - r);
+    p = xifo_element(c, r);
+    for(i = 0; i < first; i++, p += c->esize){
+        fn(p, ctx);
+    }
+    p = c->startpool;
+    for(i = 0; i < c->count - first; i++, p += c->esize){
+        fn(p, ctx);
+    }
+    return c->count;
+}
+
+/**
+ * @brief   Pop every element, least recent first (fifo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @details Same as xifo_for_each_lr, afterwards the buffer is empty and
+ *					the elements are emptied as with xifo_pop_lr.
+ *
+ * @param[in] c			Pointer to @p xifo_t used for configuration.
+ * @param[in] fn		Called with each element
+ * @param[in] ctx		Passed to fn
+ *
+ * @return	Number of elements popped
+ */
+uint32_t xifo_drain_lr(xifo_t *c, void (*fn)(const void *data, void *ctx), void *ctx){
+    uint32_t n = xifo_for_each_lr(c, fn, ctx);
+    uint32_t r = c->read + c->size + 1 - c->count;
+    uint32_t first;
+    if(n == 0){
+        return 0;
+    }
+    if(r >= c->size){
+        r -= c->size;
+    }
+    first = (n < c->size - r) ? n : (c->size - r);
+    memset(xifo_element(c, r), 0, first * c->esize);
+    memset(c->startpool, 0, (n - first) * c->esize);
+    c->count = 0;
+    c->full = 0;
+    return n;
+}
+
+/**
+ * @brief   Timestamp of the least recent record of a ring
+ */
+static uint32_t xifo_merge_head(xifo_merge_t *m, xifo_t *c){
+    uint32_t index = c->read + c->size + 1 - c->count;
+    uint32_t ts;
+    if(index >= c->size){
+        index -= c->size;
+    }
+    memcpy(&ts, xifo_element(c, index) + m->offset, sizeof(ts));
+    return ts;
+}
+
+/**
+ * @brief   Timestamp order, wraps like a free running 32 bit timer
+ */
+static inline uint32_t xifo_merge_before(xifo_merge_node_t *a, xifo_merge_node_t *b){
+    return (int32_t)(a->ts - b->ts) < 0;
+}
+
+/**
+ * @brief   Restore heap order from node i down
+ */
+static void xifo_merge_sift(xifo_merge_node_t *heap, uint32_t used, uint32_t i){
+    xifo_merge_node_t node = heap[i];
+    uint32_t child;
+    while((child = 2 * i + 1) < used){
+        if(child + 1 < used && xifo_merge_before(&heap[child + 1], &heap[child])){
+            child++;
+        }
+        if(!xifo_merge_before(&heap[child], &node)){
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = node;
+}
+
+/**
+ * @brief   Initialize merger object structure.
+ *
+ * @param[in] m       Pointer to @p xifo_merge_t object used for configuration.
+ * @param[in] rings   Array of initialised rings, all with the same element size.
+ * @param[in] count   Number of rings.
+ * @param[in] heap    Array of count heap nodes.
+ * @param[in] offset  Byte offset of the uint32_t timestamp in a record.
+ * @param[in] strict  1 to stop a batch when a ring runs empty, since its
+ *					next record may be older than the heads of the others.
+ */
+void xifo_merge_init(xifo_merge_t *m, xifo_t *rings, uint32_t count, xifo_merge_node_t *heap, uint32_t offset, uint32_t strict){
+    m->rings			= rings;
+    m->heap 			= heap;
+    m->count			= count;
+    m->offset			= offset;
+    m->strict			= strict;
+}
+
+/**
+ * @brief   Pop records of all rings in timestamp order
+ *
+ * @note    Ring state will be altered, the records are popped.
+ *
+ * @details Builds the heap from the current ring heads (O(N)), then every
+ *					record costs one heap update (O(log N)). Call with a large n,
+ *					the heap is only rebuilt once per call.
+ *
+ * @param[in] m			Pointer to @p xifo_merge_t used for configuration.
+ * @param[out] dst	Destination for n records, oldest first
+ * @param[in] n			Maximum number of records
+ *
+ * @return	Number of records popped
+ */
+uint32_t xifo_merge_pop_n(xifo_merge_t *m, void *dst, uint32_t n){
+    xifo_merge_node_t *heap = m->heap;
+    uint8_t *out = (uint8_t *)dst;
+    uint32_t used = 0, done = 0, i;
+    xifo_t *c;
+    /* Heads of all non-empty rings */
+    for(i = 0; i < m->count; i++){
+        if(m->rings[i].count){
+            heap[used].ts = xifo_merge_head(m, &m->rings[i]);
+            heap[used].ring = i;
+            used++;
+        }else if(m->strict){
+            return 0;
+        }
+    }
+    for(i = used / 2; i-- > 0;){
+        xifo_merge_sift(heap, used, i);
+    }
+    while(done < n && used){
+        c = &m->rings[heap[0].ring];
+        xifo_pop_lr(c, out);
+        out += c->esize;
+        done++;
+        if(c->count){
+            /* Next record of the same ring replaces the top */
+            heap[0].ts = xifo_merge_head(m, c);
+        }else if(m->strict){
+            break;
+        }else{
+            heap[0] = heap[--used];
+        }
+        xifo_merge_sift(heap, used, 0);
+    }
+    return done;
+}
+
+/** @} */
+#endif
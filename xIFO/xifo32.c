@@ -32,6 +32,7 @@
  *
  * @{
  */
+#include <string.h>
 #include "xifo.h"
 
 #if xIFO_USE_32BIT == TRUE
@@ -307,5 +308,1417 @@ uint32_t xifo32_get_full(xifo32_t *c){
     return c->full;
 }
 
+/* Slot of the element index positions after the least recent, index < count */
+static inline uint32_t xifo32_lr_slot(xifo32_t *c, uint32_t index){
+    uint32_t r = (uint32_t)(c->read - c->startpool) + 1 + index + c->size - c->count;
+    return (r >= c->size) ? (r - c->size) : r;
+}
+
+/**
+ * @brief   Write block to buffer
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @details Same result as n calls to xifo32_write, but copied in at most
+ *					two segments. Automatically overwrites oldest elements when full,
+ *					of a block larger than the buffer only the last elements remain.
+ *
+ * @param[in] c			Pointer to @p xifo32_t used for configuration.
+ * @param[in] data	Elements to add, least recent first
+ * @param[in] n			Number of elements
+ *
+ * @return	Number of free buffer elements
+ */
+uint32_t xifo32_write_n(xifo32_t *c, const uint32_t *data, uint32_t n){
+    uint32_t w, first;
+    if(n == 0){
+        return c->size - c->count;
+    }
+    w = (uint32_t)(c->write - c->startpool);
+    if(n > c->size){
+        /* Only the last size elements remain, at the same place */
+        w = (w + (n - c->size) % c->size) % c->size;
+        data += n - c->size;
+        n = c->size;
+        c->write = &c->startpool[w];
+    }
+    /* Part up to the end of the pool, then the rest from the start */
+    first = c->size - w;
+    if(first > n){
+        first = n;
+    }
+    memcpy(c->write, data, first * sizeof(uint32_t));
+    memcpy(c->startpool, &data[first], (n - first) * sizeof(uint32_t));
+    w += n;
+    if(w >= c->size){
+        w -= c->size;
+    }
+    c->write = &c->startpool[w];
+    /* Update read pointer to most recent element */
+    c->read = (w == 0) ? c->endpool : (c->write - 1);
+    /* Update count */
+    c->count += n;
+    if( c->count >= c->size ){
+        c->full = 1;
+        c->count = c->size;
+    }
+    return c->size - c->count;
+}
+
+/**
+ * @brief   Pop block of least recent elements from buffer (fifo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @details Same result as n calls to xifo32_pop_lr, the popped elements
+ *					are emptied as well.
+ *
+ * @param[in] c			Pointer to @p xifo32_t used for configuration.
+ * @param[out] dst	Destination, least recent first
+ * @param[in] n			Maximum number of elements
+ *
+ * @return	Number of elements popped
+ */
+uint32_t xifo32_pop_lr_n(xifo32_t *c, uint32_t *dst, uint32_t n){
+    uint32_t r, first;
+    if(n > c->count){
+        n = c->count;
+    }
+    if(n == 0){
+        return 0;
+    }
+    r = xifo32_lr_slot(c, 0);
+    first = c->size - r;
+    if(first > n){
+        first = n;
+    }
+    memcpy(dst, &c->startpool[r], first * sizeof(uint32_t));
+    memset(&c->startpool[r], 0, first * sizeof(uint32_t));
+    memcpy(&dst[first], c->startpool, (n - first) * sizeof(uint32_t));
+    memset(c->startpool, 0, (n - first) * sizeof(uint32_t));
+    /* Reduce count */
+    c->count -= n;
+    if(c->count < c->size)
+        c->full = 0;
+    return n;
+}
+
+/**
+ * @brief   Read block from buffer (lr) Least Recent oriented (fifo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @details Same result as xifo32_read_lr for index to index + n - 1.
+ *
+ * @param[in] c			Pointer to @p xifo32_t used for configuration.
+ * @param[out] dst	Destination, least recent first
+ * @param[in] index	Index relative from least recent of the first element
+ * @param[in] n			Maximum number of elements
+ *
+ * @return	Number of elements read
+ */
+uint32_t xifo32_read_lr_n(xifo32_t *c, uint32_t *dst, uint32_t index, uint32_t n){
+    uint32_t r, first;
+    if(index >= c->count){
+        return 0;	/* Nothing to read there */
+    }
+    if(n > c->count - index){
+        n = c->count - index;
+    }
+    r = xifo32_lr_slot(c, index);
+    first = c->size - r;
+    if(first > n){
+        first = n;
+    }
+    memcpy(dst, &c->startpool[r], first * sizeof(uint32_t));
+    memcpy(&dst[first], c->startpool, (n - first) * sizeof(uint32_t));
+    return n;
+}
+
+/**
+ * @brief   Peek at the least recent elements in place (fifo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @details Returns the largest contiguous run starting at the least recent
+ *					element, so it can be handed to write(2), a CRC engine or DMA
+ *					without copying. Follow up with xifo32_consume.
+ *
+ * @param[in] c			Pointer to @p xifo32_t used for configuration.
+ * @param[out] ptr	Least recent element
+ * @param[out] len	Number of contiguous elements, 0 if empty
+ */
+void xifo32_peek_contiguous(xifo32_t *c, const uint32_t **ptr, uint32_t *len){
+    uint32_t r;
+    if(c->count == 0){
+        *ptr = c->startpool;
+        *len = 0;
+        return;
+    }
+    r = xifo32_lr_slot(c, 0);
+    *ptr = &c->startpool[r];
+    *len = (c->count < c->size - r) ? c->count : (c->size - r);
+}
+
+/**
+ * @brief   Peek at all elements in place as two segments (fifo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @details The first segment is the one of xifo32_peek_contiguous, the
+ *					second one is the part after the wrap (len2 is 0 if none).
+ *
+ * @param[in] c			Pointer to @p xifo32_t used for configuration.
+ * @param[out] ptr1	Least recent element
+ * @param[out] len1	Number of elements in the first segment
+ * @param[out] ptr2	Start of the second segment
+ * @param[out] len2	Number of elements in the second segment
+ */
+void xifo32_peek_segments(xifo32_t *c, const uint32_t **ptr1, uint32_t *len1, const uint32_t **ptr2, uint32_t *len2){
+    xifo32_peek_contiguous(c, ptr1, len1);
+    *ptr2 = c->startpool;
+    *len2 = c->count - *len1;
+}
+
+/**
+ * @brief   Remove least recent elements that were processed in place
+ *
+ * @note    Buffer state will be altered, the elements are not emptied.
+ *
+ * @param[in] c	Pointer to @p xifo32_t used for configuration.
+ * @param[in] n	Number of elements to remove
+ *
+ * @return	Number of elements removed
+ */
+uint32_t xifo32_consume(xifo32_t *c, uint32_t n){
+    if(n > c->count){
+        n = c->count;
+    }
+    c->count -= n;
+    if(c->count < c->size)
+        c->full = 0;
+    return n;
+}
+
+/**
+ * @brief   Visit every element from least recent to most recent (fifo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @details Walks both pool segments in a plain loop, no wrap check per
+ *					element. fn must not modify the buffer.
+ *
+ * @param[in] c			Pointer to @p xifo32_t used for configuration.
+ * @param[in] fn		Called with each element
+ * @param[in] ctx		Passed to fn
+ *
+ * @return	Number of elements visited
+ */
+uint32_t xifo32_for_each_lr(xifo32_t *c, void (*fn)(uint32_t data, void *ctx), void *ctx){
+    const uint32_t *p1, *p2;
+    uint32_t n1, n2, i;
+    xifo32_peek_segments(c, &p1, &n1, &p2, &n2);
+    for(i = 0; i < n1; i++){
+        fn(p1[i], ctx);
+    }
+    for(i = 0; i < n2; i++){
+        fn(p2[i], ctx);
+    }
+    return n1 + n2;
+}
+
+/**
+ * @brief   Pop every element, least recent first (fifo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @details Same as xifo32_for_each_lr, afterwards the buffer is empty and
+ *					the elements are emptied as with xifo32_pop_lr.
+ *
+ * @param[in] c			Pointer to @p xifo32_t used for configuration.
+ * @param[in] fn		Called with each element
+ * @param[in] ctx		Passed to fn
+ *
+ * @return	Number of elements popped
+ */
+uint32_t xifo32_drain_lr(xifo32_t *c, void (*fn)(uint32_t data, void *ctx), void *ctx){
+    const uint32_t *p1, *p2;
+    uint32_t n1, n2;
+    uint32_t n = xifo32_for_each_lr(c, fn, ctx);
+    xifo32_peek_segments(c, &p1, &n1, &p2, &n2);
+    memset((uint32_t *)p1, 0, n1 * sizeof(uint32_t));
+    memset((uint32_t *)p2, 0, n2 * sizeof(uint32_t));
+    c->count = 0;
+    c->full = 0;
+    return n;
+}
+
+#if xIFO_USE_ATOMIC == TRUE
+/*
+ * SPSC positions run from 0 to 2*size-1, which keeps full and empty apart
+ * without a shared count. The pool slot is the position modulo size.
+ */
+
+/**
+ * @brief   Number of elements between two SPSC positions
+ */
+static inline uint32_t xifo32_spsc_distance(xifo32_spsc_t *c, uint32_t r, uint32_t w){
+    return (w >= r) ? (w - r) : (w + (c->size << 1) - r);
+}
+
+/**
+ * @brief   Pool slot of a SPSC position
+ */
+static inline uint32_t *xifo32_spsc_slot(xifo32_spsc_t *c, uint32_t p){
+    return &c->startpool[(p < c->size) ? p : (p - c->size)];
+}
+
+/**
+ * @brief   Advance a SPSC position by n
+ */
+static inline uint32_t xifo32_spsc_advance(xifo32_spsc_t *c, uint32_t p, uint32_t n){
+    p += n;
+    if(p >= (c->size << 1)){
+        p -= (c->size << 1);
+    }
+    return p;
+}
+
+/**
+ * @brief   Publish n written elements and notify a sleeping consumer
+ */
+static inline void xifo32_spsc_publish(xifo32_spsc_t *c, uint32_t w, uint32_t n){
+    atomic_store_explicit(&c->write, xifo32_spsc_advance(c, w, n), memory_order_release);
+#if xIFO_USE_LINUX == TRUE
+    /* Wake consumer only when it sleeps */
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(&c->rwait, memory_order_relaxed)){
+        xifo_futex_wake(&c->write, 1);
+    }
+    /* Ring the doorbell only on empty to non-empty */
+    if(c->rfd >= 0 && atomic_load_explicit(&c->read, memory_order_relaxed) == w){
+        xifo_eventfd_signal(c->rfd);
+    }
+#endif
+}
+
+/**
+ * @brief   Hand n read slots back and notify a sleeping producer
+ */
+static inline void xifo32_spsc_hand_back(xifo32_spsc_t *c, uint32_t r, uint32_t n){
+    atomic_store_explicit(&c->read, xifo32_spsc_advance(c, r, n), memory_order_release);
+#if xIFO_USE_LINUX == TRUE
+    /* Wake producer only when it sleeps */
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(&c->wwait, memory_order_relaxed)){
+        xifo_futex_wake(&c->read, 1);
+    }
+    /* Ring the doorbell only on full to non-full */
+    if(c->wfd >= 0 && xifo32_spsc_distance(c, r, atomic_load_explicit(&c->write, memory_order_relaxed)) >= c->size){
+        xifo_eventfd_signal(c->wfd);
+    }
+#endif
+}
+
+/**
+ * @brief   Initialize lock-free buffer object structure.
+ *
+ * @note    Does not clear memory pool.
+ * @note    Size is limited to 2^31-1 elements.
+ *
+ * @param[in] c   Pointer to @p xifo32_spsc_t object used for configuration.
+ * @param[in] s   Number of elements buffer can hold (size).
+ * @param[in] sp  Start of pre-allocated memory pool.
+ */
+void xifo32_spsc_init(xifo32_spsc_t *c, uint32_t s, uint32_t *sp){
+    c->startpool		= sp;
+    c->size 			= s;
+    c->rcache			= 0;
+    c->wcache			= 0;
+    c->reserved			= 0;
+    c->peeked			= 0;
+    atomic_init(&c->write, 0);
+    atomic_init(&c->read, 0);
+    atomic_init(&c->rwait, 0);
+    atomic_init(&c->wwait, 0);
+    c->rfd				= -1;
+    c->wfd				= -1;
+}
+
+/**
+ * @brief   Write to buffer (producer)
+ *
+ * @note    Safe to run concurrently with the consumer functions.
+ *          Only one thread (or ISR) may write.
+ *
+ * @details Adds a value to the buffer.
+ *					Unlike xifo32_write this never overwrites, the consumer
+ *					owns the elements it has not yet popped.
+ *
+ * @param[in] c			Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[in] data	Data to add to buffer
+ *
+ * @return	1 if written, 0 if buffer was full
+ */
+uint32_t xifo32_spsc_write(xifo32_spsc_t *c, uint32_t data){
+    register uint32_t w = atomic_load_explicit(&c->write, memory_order_relaxed);
+    /* Verify free space, only refresh read position when cached copy is full */
+    if(xifo32_spsc_distance(c, c->rcache, w) >= c->size){
+        c->rcache = atomic_load_explicit(&c->read, memory_order_acquire);
+        if(xifo32_spsc_distance(c, c->rcache, w) >= c->size){
+            return 0;	/* Full */
+        }
+    }
+    /* Write data */
+    *xifo32_spsc_slot(c, w) = data;
+    /* Publish to consumer */
+    xifo32_spsc_publish(c, w, 1);
+    return 1;
+}
+
+/**
+ * @brief   Pop (lr) least recent from buffer (consumer)
+ *
+ * @note    Safe to run concurrently with the producer.
+ *          Only one thread (or ISR) may pop.
+ *
+ * @param[in]  c	Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[out] data	Contents of element
+ *
+ * @return	1 if an element was popped, 0 if buffer was empty
+ */
+uint32_t xifo32_spsc_pop_lr(xifo32_spsc_t *c, uint32_t *data){
+    register uint32_t r = atomic_load_explicit(&c->read, memory_order_relaxed);
+    /* Verify there is valid data, only refresh write position when cached copy is empty */
+    if(r == c->wcache){
+        c->wcache = atomic_load_explicit(&c->write, memory_order_acquire);
+        if(r == c->wcache){
+            return 0;	/* Nothing to read there */
+        }
+    }
+    /* Read oldest buffer element */
+    *data = *xifo32_spsc_slot(c, r);
+    /* Hand slot back to producer */
+    xifo32_spsc_hand_back(c, r, 1);
+    return 1;
+}
+
+/**
+ * @brief   Read from buffer (lr) Least Recent oriented (consumer)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @param[in] c   		Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[in] index   Index relative from least recent
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_spsc_read_lr(xifo32_spsc_t *c, uint32_t index){
+    register uint32_t r = atomic_load_explicit(&c->read, memory_order_relaxed);
+    if(index >= xifo32_spsc_distance(c, r, c->wcache)){
+        c->wcache = atomic_load_explicit(&c->write, memory_order_acquire);
+        if(index >= xifo32_spsc_distance(c, r, c->wcache)){
+            return 0;	/* Nothing to read there */
+        }
+    }
+    return *xifo32_spsc_slot(c, xifo32_spsc_advance(c, r, index));
+}
+
+/**
+ * @brief   Get buffer size
+ *
+ * @param[in] c	Pointer to @p xifo32_spsc_t used for configuration.
+ *
+ * @return	Size of memory pool in elements
+ */
+uint32_t xifo32_spsc_get_size(xifo32_spsc_t *c){
+    return c->size;
+}
+
+/**
+ * @brief   Get number of used elements
+ *
+ * @note    Only a snapshot while the other side is running.
+ *
+ * @param[in] c	Pointer to @p xifo32_spsc_t used for configuration.
+ *
+ * @return	Number of used buffer elements
+ */
+uint32_t xifo32_spsc_get_used(xifo32_spsc_t *c){
+    register uint32_t r = atomic_load_explicit(&c->read, memory_order_acquire);
+    register uint32_t w = atomic_load_explicit(&c->write, memory_order_acquire);
+    register uint32_t used = xifo32_spsc_distance(c, r, w);
+    /* Both positions may have moved in between the loads */
+    return (used > c->size) ? c->size : used;
+}
+
+/**
+ * @brief   Get number of free elements
+ *
+ * @param[in] c	Pointer to @p xifo32_spsc_t used for configuration.
+ *
+ * @return	Number of free elements
+ */
+uint32_t xifo32_spsc_get_free(xifo32_spsc_t *c){
+    return c->size - xifo32_spsc_get_used(c);
+}
+
+/**
+ * @brief   Get full flag
+ *
+ * @param[in] c	Pointer to @p xifo32_spsc_t used for configuration.
+ *
+ * @return	1 if full
+ */
+uint32_t xifo32_spsc_get_full(xifo32_spsc_t *c){
+    return (xifo32_spsc_get_used(c) >= c->size);
+}
+
+/**
+ * @brief   Reserve contiguous slots to write (producer)
+ *
+ * @note    Do not mix with xifo32_spsc_write while slots are reserved.
+ *
+ * @details Returns slots following the ones already reserved, so a block
+ *					that wraps is reserved with two calls and committed once.
+ *					Nothing is visible to the consumer until commit.
+ *
+ * @param[in]  c	Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[out] ptr	First reserved slot
+ * @param[in]  n	Wanted number of slots
+ *
+ * @return	Number of contiguous slots reserved, 0 if full
+ */
+uint32_t xifo32_spsc_reserve(xifo32_spsc_t *c, uint32_t **ptr, uint32_t n){
+    register uint32_t p = xifo32_spsc_advance(c, atomic_load_explicit(&c->write, memory_order_relaxed), c->reserved);
+    register uint32_t room = c->size - xifo32_spsc_distance(c, c->rcache, p);
+    register uint32_t slot;
+    if(room < n){
+        c->rcache = atomic_load_explicit(&c->read, memory_order_acquire);
+        room = c->size - xifo32_spsc_distance(c, c->rcache, p);
+    }
+    /* Limit to end of pool */
+    slot = (p < c->size) ? p : (p - c->size);
+    if(room > c->size - slot){
+        room = c->size - slot;
+    }
+    if(n > room){
+        n = room;
+    }
+    *ptr = &c->startpool[slot];
+    c->reserved += n;
+    return n;
+}
+
+/**
+ * @brief   Publish reserved slots (producer)
+ *
+ * @details One release store (and wake up check) for the whole block.
+ *
+ * @param[in] c	Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[in] n	Number of slots written, at most the number reserved
+ */
+void xifo32_spsc_commit(xifo32_spsc_t *c, uint32_t n){
+    if(n > c->reserved){
+        n = c->reserved;
+    }
+    if(n == 0){
+        return;
+    }
+    c->reserved -= n;
+    xifo32_spsc_publish(c, atomic_load_explicit(&c->write, memory_order_relaxed), n);
+}
+
+/**
+ * @brief   Peek contiguous elements to read (consumer)
+ *
+ * @note    Do not mix with xifo32_spsc_pop_lr while elements are peeked.
+ *
+ * @details Returns elements following the ones already peeked, from least
+ *					recent on. The producer cannot reuse them until release.
+ *
+ * @param[in]  c	Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[out] ptr	First element
+ * @param[in]  n	Wanted number of elements
+ *
+ * @return	Number of contiguous elements, 0 if empty
+ */
+uint32_t xifo32_spsc_peek(xifo32_spsc_t *c, const uint32_t **ptr, uint32_t n){
+    register uint32_t p = xifo32_spsc_advance(c, atomic_load_explicit(&c->read, memory_order_relaxed), c->peeked);
+    register uint32_t avail = xifo32_spsc_distance(c, p, c->wcache);
+    register uint32_t slot;
+    if(avail < n){
+        c->wcache = atomic_load_explicit(&c->write, memory_order_acquire);
+        avail = xifo32_spsc_distance(c, p, c->wcache);
+    }
+    /* Limit to end of pool */
+    slot = (p < c->size) ? p : (p - c->size);
+    if(avail > c->size - slot){
+        avail = c->size - slot;
+    }
+    if(n > avail){
+        n = avail;
+    }
+    *ptr = &c->startpool[slot];
+    c->peeked += n;
+    return n;
+}
+
+/**
+ * @brief   Hand peeked elements back to the producer (consumer)
+ *
+ * @param[in] c	Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[in] n	Number of elements consumed, at most the number peeked
+ */
+void xifo32_spsc_release(xifo32_spsc_t *c, uint32_t n){
+    if(n > c->peeked){
+        n = c->peeked;
+    }
+    if(n == 0){
+        return;
+    }
+    c->peeked -= n;
+    xifo32_spsc_hand_back(c, atomic_load_explicit(&c->read, memory_order_relaxed), n);
+}
+
+#if xIFO_USE_LINUX == TRUE
+/**
+ * @brief   Write to buffer, wait while full (producer)
+ *
+ * @details Spins xIFO_SPIN_COUNT times, then sleeps on a futex until the
+ *					consumer pops. The consumer only makes the futex call when
+ *					this side is actually sleeping.
+ *
+ * @param[in] c			Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[in] data	Data to add to buffer
+ * @param[in] timeout	Timeout in milliseconds, 0 to not wait or xIFO_WAIT_FOREVER
+ *
+ * @return	1 if written, 0 on timeout
+ */
+uint32_t xifo32_spsc_write_wait(xifo32_spsc_t *c, uint32_t data, uint32_t timeout){
+    register uint32_t spin = 0;
+    uint32_t start = 0, elapsed, r;
+    for(;;){
+        if(xifo32_spsc_write(c, data)){
+            return 1;
+        }
+        if(timeout == 0){
+            return 0;
+        }
+        if(spin++ == 0){
+            start = xifo_time_ms();
+        }
+        if(spin <= xIFO_SPIN_COUNT){
+            /* Consumer is probably running, poll a little */
+            xIFO_CPU_RELAX();
+            continue;
+        }
+        elapsed = xifo_time_ms() - start;
+        if(timeout != xIFO_WAIT_FOREVER && elapsed >= timeout){
+            return 0;
+        }
+        /* Announce, then re-check before sleeping on the read position */
+        atomic_store_explicit(&c->wwait, 1, memory_order_seq_cst);
+        r = atomic_load_explicit(&c->read, memory_order_seq_cst);
+        if(xifo32_spsc_distance(c, r, atomic_load_explicit(&c->write, memory_order_relaxed)) >= c->size){
+            xifo_futex_wait(&c->read, r, (timeout == xIFO_WAIT_FOREVER) ? timeout : (timeout - elapsed));
+        }
+        atomic_store_explicit(&c->wwait, 0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief   Pop (lr) least recent from buffer, wait while empty (consumer)
+ *
+ * @details Spins xIFO_SPIN_COUNT times, then sleeps on a futex until the
+ *					producer writes. The producer only makes the futex call when
+ *					this side is actually sleeping.
+ *
+ * @param[in]  c	Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[out] data	Contents of element
+ * @param[in]  timeout	Timeout in milliseconds, 0 to not wait or xIFO_WAIT_FOREVER
+ *
+ * @return	1 if an element was popped, 0 on timeout
+ */
+uint32_t xifo32_spsc_pop_lr_wait(xifo32_spsc_t *c, uint32_t *data, uint32_t timeout){
+    register uint32_t spin = 0;
+    uint32_t start = 0, elapsed, w;
+    for(;;){
+        if(xifo32_spsc_pop_lr(c, data)){
+            return 1;
+        }
+        if(timeout == 0){
+            return 0;
+        }
+        if(spin++ == 0){
+            start = xifo_time_ms();
+        }
+        if(spin <= xIFO_SPIN_COUNT){
+            /* Producer is probably running, poll a little */
+            xIFO_CPU_RELAX();
+            continue;
+        }
+        elapsed = xifo_time_ms() - start;
+        if(timeout != xIFO_WAIT_FOREVER && elapsed >= timeout){
+            return 0;
+        }
+        /* Announce, then re-check before sleeping on the write position */
+        atomic_store_explicit(&c->rwait, 1, memory_order_seq_cst);
+        w = atomic_load_explicit(&c->write, memory_order_seq_cst);
+        if(w == atomic_load_explicit(&c->read, memory_order_relaxed)){
+            xifo_futex_wait(&c->write, w, (timeout == xIFO_WAIT_FOREVER) ? timeout : (timeout - elapsed));
+        }
+        atomic_store_explicit(&c->rwait, 0, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief   Attach eventfd doorbells for epoll
+ *
+ * @note    Call before producer and consumer start.
+ *
+ * @details The producer signals @p readable only when the buffer goes
+ *					from empty to non-empty, the consumer signals @p writable
+ *					only when it goes from full to non-full. Bursts coalesce
+ *					into one wake up. The consumer should call
+ *					xifo_eventfd_ack() first and then pop until empty.
+ *
+ * @param[in] c			Pointer to @p xifo32_spsc_t used for configuration.
+ * @param[in] readable	eventfd for the consumer, -1 for none
+ * @param[in] writable	eventfd for the producer, -1 for none
+ */
+void xifo32_spsc_set_eventfd(xifo32_spsc_t *c, int readable, int writable){
+    c->rfd 				= readable;
+    c->wfd 				= writable;
+}
+#endif
+#endif
+
+#if xIFO_USE_ATOMIC == TRUE
+/*
+ * Broadcast sequences wrap at span, a multiple of size below 2^31, so the
+ * slot of a sequence is always sequence modulo size.
+ */
+
+/**
+ * @brief   Number of elements between two broadcast sequences
+ */
+static inline uint32_t xifo32_bc_distance(xifo32_bc_t *c, uint32_t r, uint32_t w){
+    return (w >= r) ? (w - r) : (w + c->span - r);
+}
+
+/**
+ * @brief   Initialize broadcast buffer object structure.
+ *
+ * @note    Does not clear memory pool.
+ * @note    Size must be at least 2, readers can lag size-1 elements.
+ *
+ * @param[in] c   Pointer to @p xifo32_bc_t object used for configuration.
+ * @param[in] s   Number of elements buffer can hold (size).
+ * @param[in] sp  Start of pre-allocated memory pool.
+ */
+void xifo32_bc_init(xifo32_bc_t *c, uint32_t s, uint32_t *sp){
+    c->startpool		= sp;
+    c->size 			= s;
+    c->span 			= (0x80000000UL / s) * s;
+    c->windex			= 0;
+    c->wseq 			= 0;
+    atomic_init(&c->seq, 0);
+    atomic_init(&c->wrapped, 0);
+}
+
+/**
+ * @brief   Write to buffer (single writer)
+ *
+ * @note    Never waits for readers, the oldest element is overwritten.
+ *          Only one thread (or ISR) may write.
+ *
+ * @param[in] c			Pointer to @p xifo32_bc_t used for configuration.
+ * @param[in] data	Data to add to buffer
+ */
+void xifo32_bc_write(xifo32_bc_t *c, uint32_t data){
+    /* Previous publish must be visible before this slot changes */
+    atomic_thread_fence(memory_order_release);
+    /* Write data */
+    c->startpool[c->windex] = data;
+    /* Advance */
+    if(++c->windex >= c->size){
+        c->windex = 0;
+    }
+    if(++c->wseq >= c->span){
+        c->wseq = 0;
+        atomic_store_explicit(&c->wrapped, 1, memory_order_relaxed);
+    }
+    /* Publish to readers */
+    atomic_store_explicit(&c->seq, c->wseq, memory_order_release);
+}
+
+/**
+ * @brief   Initialize reader cursor.
+ *
+ * @details The reader starts at the most recent write,
+ *					it will only see elements written from now on.
+ *
+ * @param[in] c   Pointer to @p xifo32_bc_t used for configuration.
+ * @param[in] r   Pointer to @p xifo32_bc_reader_t cursor.
+ */
+void xifo32_bc_reader_init(xifo32_bc_t *c, xifo32_bc_reader_t *r){
+    r->seq 				= atomic_load_explicit(&c->seq, memory_order_acquire);
+    r->index			= r->seq % c->size;
+    r->lost 			= 0;
+}
+
+/**
+ * @brief   Read from buffer (lr) Least Recent oriented, per reader (fifo)
+ *
+ * @note    Buffer state will be preserved, only the cursor advances.
+ *
+ * @details Returns the oldest element this reader has not read yet.
+ *					When the writer lapped the reader it skips to the oldest
+ *					element still in the pool and adds the skipped ones to lost.
+ *					The slot the writer may be busy with is never read.
+ *
+ * @param[in]  c   	Pointer to @p xifo32_bc_t used for configuration.
+ * @param[in]  r   	Pointer to @p xifo32_bc_reader_t cursor.
+ * @param[out] data	Contents of element
+ *
+ * @return	1 if an element was read, 0 if reader is up to date
+ */
+uint32_t xifo32_bc_read_lr(xifo32_bc_t *c, xifo32_bc_reader_t *r, uint32_t *data){
+    register uint32_t ahead;
+    uint32_t temp;
+    for(;;){
+        ahead = xifo32_bc_distance(c, r->seq, atomic_load_explicit(&c->seq, memory_order_acquire));
+        if(ahead == 0){
+            return 0;	/* Nothing to read there */
+        }
+        if(ahead >= c->size){
+            /* Lapped, skip to the oldest element that is safe to read */
+            ahead -= c->size - 1;
+            r->lost += ahead;
+            r->seq += ahead;
+            if(r->seq >= c->span){
+                r->seq -= c->span;
+            }
+            r->index = r->seq % c->size;
+        }
+        /* Copy, then verify the writer did not reach this slot meanwhile */
+        temp = c->startpool[r->index];
+        atomic_thread_fence(memory_order_acquire);
+        ahead = xifo32_bc_distance(c, r->seq, atomic_load_explicit(&c->seq, memory_order_relaxed));
+        if(ahead < c->size){
+            break;
+        }
+    }
+    *data = temp;
+    if(++r->index >= c->size){
+        r->index = 0;
+    }
+    if(++r->seq >= c->span){
+        r->seq = 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief   Get number of elements this reader has not read yet
+ *
+ * @param[in] c	Pointer to @p xifo32_bc_t used for configuration.
+ * @param[in] r	Pointer to @p xifo32_bc_reader_t cursor.
+ *
+ * @return	Number of unread elements, at most size-1
+ */
+uint32_t xifo32_bc_get_used(xifo32_bc_t *c, xifo32_bc_reader_t *r){
+    register uint32_t ahead = xifo32_bc_distance(c, r->seq, atomic_load_explicit(&c->seq, memory_order_acquire));
+    return (ahead >= c->size) ? (c->size - 1) : ahead;
+}
+
+/**
+ * @brief   Get number of elements lost by being lapped
+ *
+ * @param[in] r	Pointer to @p xifo32_bc_reader_t cursor.
+ *
+ * @return	Total number of elements this reader missed
+ */
+uint32_t xifo32_bc_get_lost(xifo32_bc_reader_t *r){
+    return r->lost;
+}
+
+/**
+ * @brief   Copy the most recent history without blocking the writer
+ *
+ * @note    Buffer state will be preserved, no reader cursor is used.
+ *
+ * @details Seqlock style: copies the last n elements, then checks the
+ *					published sequence again. Only when the writer got far enough
+ *					to overwrite the copied region the copy is repeated.
+ *					For DSP application, the ISR writer never waits.
+ *
+ * @param[in]  c   	Pointer to @p xifo32_bc_t used for configuration.
+ * @param[out] dst 	Destination, dst[n-1] receives the most recent element
+ * @param[in]  n   	Number of elements to copy, at most size-1
+ *
+ * @return	Number of elements copied (less than n when not written yet)
+ */
+uint32_t xifo32_bc_snapshot_mr(xifo32_bc_t *c, uint32_t *dst, uint32_t n){
+    register uint32_t w, first, avail;
+    for(;;){
+        w = atomic_load_explicit(&c->seq, memory_order_acquire);
+        avail = atomic_load_explicit(&c->wrapped, memory_order_relaxed) ? c->size : w;
+        if(avail > c->size - 1){
+            avail = c->size - 1;
+        }
+        if(n > avail){
+            n = avail;
+        }
+        /* Slot of the oldest element to copy */
+        first = w % c->size;
+        first = (first >= n) ? (first - n) : (first + c->size - n);
+        /* Copy in at most two segments */
+        if(first + n <= c->size){
+            memcpy(dst, &c->startpool[first], n * sizeof(uint32_t));
+        }else{
+            memcpy(dst, &c->startpool[first], (c->size - first) * sizeof(uint32_t));
+            memcpy(&dst[c->size - first], c->startpool, (n - (c->size - first)) * sizeof(uint32_t));
+        }
+        /* Retry only when the writer reached the copied region */
+        atomic_thread_fence(memory_order_acquire);
+        if(xifo32_bc_distance(c, w, atomic_load_explicit(&c->seq, memory_order_relaxed)) + n < c->size){
+            return n;
+        }
+    }
+}
+#endif
+
+
+/**
+ * @brief   Count leading zeros of a non zero word.
+ * @note    Override with the instruction of your core (e.g. CMSIS __CLZ).
+ */
+#if !defined(xIFO_CLZ)
+#if defined(__GNUC__) || defined(__clang__)
+#define xIFO_CLZ(x)		((uint32_t)__builtin_clz(x))
+#else
+static uint32_t xifo32_clz(uint32_t x){
+    uint32_t n = 0;
+    if(!(x & 0xFFFF0000)){ n += 16; x <<= 16; }
+    if(!(x & 0xFF000000)){ n += 8;  x <<= 8;  }
+    if(!(x & 0xF0000000)){ n += 4;  x <<= 4;  }
+    if(!(x & 0xC0000000)){ n += 2;  x <<= 2;  }
+    if(!(x & 0x80000000)){ n += 1; }
+    return n;
+}
+#define xIFO_CLZ(x)		xifo32_clz(x)
+#endif
+#endif
+
+/**
+ * @brief   Initialize priority set.
+ *
+ * @note    The level buffers must be initialised, they may hold data.
+ *
+ * @param[in] c       Pointer to @p xifo32_prio_t object used for configuration.
+ * @param[in] levels  Number of levels, 1 to 32, more are clamped to 32.
+ * @param[in] level   Array of @p levels initialised buffers, [0] is highest priority.
+ * @param[in] quota   Array of @p levels quotas or NULL, 0 is no limit.
+ */
+void xifo32_prio_init(xifo32_prio_t *c, uint32_t levels, xifo32_t *level, const uint32_t *quota){
+    uint32_t i;
+    /* One bit per level in the bitmaps */
+    if(levels > 32){
+        levels = 32;
+    }
+    c->level			= level;
+    c->quota			= quota;
+    c->levels			= levels;
+    c->nonempty			= 0;
+    c->exhausted		= 0;
+    c->runlevel			= 0;
+    c->run				= 0;
+    for(i = 0; i < levels; i++){
+        if(level[i].count){
+            c->nonempty |= 0x80000000UL >> i;
+        }
+    }
+}
+
+/**
+ * @brief   Write to a priority level
+ *
+ * @details Same as xifo32_write on the level buffer, it overwrites the
+ *          oldest element of that level when full.
+ *
+ * @param[in] c     Pointer to @p xifo32_prio_t used for configuration.
+ * @param[in] prio  Level to write to, 0 is highest priority.
+ * @param[in] data  Data to add to buffer
+ *
+ * @return	Number of free elements in that level, 0 for an invalid level
+ */
+uint32_t xifo32_prio_write(xifo32_prio_t *c, uint32_t prio, uint32_t data){
+    if(prio >= c->levels){
+        return 0;
+    }
+    c->nonempty |= 0x80000000UL >> prio;
+    return xifo32_write(&c->level[prio], data);
+}
+
+/**
+ * @brief   Pop least recent element of the highest priority level
+ *
+ * @note    Buffer state will be altered
+ *
+ * @details A level that popped its quota in a row while a lower level
+ *          has data is skipped until a lower level got an element out.
+ *
+ * @param[in] c	Pointer to @p xifo32_prio_t used for configuration.
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_prio_pop(xifo32_prio_t *c){
+    uint32_t mask, bit, i;
+    for(;;){
+        if(c->nonempty == 0){
+            return 0;
+        }
+        /* Highest level with data that still has quota */
+        mask = c->nonempty & ~c->exhausted;
+        if(mask == 0){
+            /* Only exhausted levels left, start over */
+            c->exhausted = 0;
+            mask = c->nonempty;
+        }
+        i = xIFO_CLZ(mask);
+        bit = 0x80000000UL >> i;
+        if(c->level[i].count){
+            break;
+        }
+        /* Level was popped directly by the application */
+        c->nonempty &= ~bit;
+        c->exhausted &= ~bit;
+    }
+    /* A lower level got its turn, levels above may run again */
+    c->exhausted &= (bit - 1) | bit;
+    if(i == c->runlevel){
+        c->run++;
+    }else{
+        c->runlevel = i;
+        c->run = 1;
+    }
+    if(c->level[i].count <= 1){
+        c->nonempty &= ~bit;
+        c->run = 0;
+    }else if(c->quota && c->quota[i] && c->run >= c->quota[i] && (c->nonempty & (bit - 1))){
+        c->exhausted |= bit;
+        c->run = 0;
+    }
+    return xifo32_pop_lr(&c->level[i]);
+}
+
+/**
+ * @brief   Get highest priority level with data
+ *
+ * @param[in] c	Pointer to @p xifo32_prio_t used for configuration.
+ *
+ * @return	Level, or the number of levels when all are empty
+ */
+uint32_t xifo32_prio_get_level(xifo32_prio_t *c){
+    uint32_t i;
+    while(c->nonempty){
+        i = xIFO_CLZ(c->nonempty);
+        if(c->level[i].count){
+            return i;
+        }
+        /* Level was popped directly by the application */
+        c->nonempty &= ~(0x80000000UL >> i);
+    }
+    return c->levels;
+}
+
+/**
+ * @brief   Initialize power of two buffer object structure.
+ *
+ * @note    Does not clear memory pool.
+ *
+ * @details A size that is not a power of two is rounded down, 0 is taken
+ *          as 1 so the pool must hold at least one element.
+ *
+ * @param[in] c   Pointer to @p xifo32_p2_t object used for configuration.
+ * @param[in] s   Number of elements buffer can hold (size).
+ * @param[in] sp  Start of pre-allocated memory pool.
+ */
+void xifo32_p2_init(xifo32_p2_t *c, uint32_t s, uint32_t *sp){
+    /* Size 0 would give an all ones mask */
+    if(s == 0){
+        s = 1;
+    }
+    /* Keep the highest bit only */
+    while(s & (s - 1)){
+        s &= s - 1;
+    }
+    c->startpool		= sp;
+    c->mask 			= s - 1;
+    c->head 			= 0;
+    c->count            = 0;
+}
+
+/**
+ * @brief   Clear buffer memory pool
+ *
+ * @note    Must be used on initialised buffer object.
+ *
+ * @param[in] c   Pointer to @p xifo32_p2_t object.
+ */
+void xifo32_p2_clear(xifo32_p2_t *c){
+    memset(c->startpool, 0, (c->mask + 1) * sizeof(uint32_t));
+}
+
+/**
+ * @brief   Write to buffer
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @details Adds a value to the buffer.
+ *					Automatically overwrites oldest elements when full.
+ *
+ * @param[in] c			Pointer to @p xifo32_p2_t used for configuration.
+ * @param[in] data	Data to add to buffer
+ *
+ * @return	Number of free buffer elements
+ */
+uint32_t xifo32_p2_write(xifo32_p2_t *c, uint32_t data){
+    c->startpool[c->head++ & c->mask] = data;
+    /* Saturates at size */
+    c->count += (c->count <= c->mask);
+    return (c->mask + 1) - c->count;
+}
+
+/**
+ * @brief   Read from buffer (lr) Least Recent oriented (fifo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @param[in] c   		Pointer to @p xifo32_p2_t used for configuration.
+ * @param[in] index   Index relative from least recent
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_p2_read_lr(xifo32_p2_t *c, uint32_t index){
+    if(index >= c->count){
+        return 0;	/* Nothing to read there */
+    }
+    return c->startpool[(c->head - c->count + index) & c->mask];
+}
+
+/**
+ * @brief   Read from buffer (mr) Most Recent oriented (filo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @param[in] c   		Pointer to @p xifo32_p2_t used for configuration.
+ * @param[in] index   Index relative from most recent
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_p2_read_mr(xifo32_p2_t *c, uint32_t index){
+    if(index >= c->count){
+        return 0;	/* Nothing to read there */
+    }
+    return c->startpool[(c->head - 1 - index) & c->mask];
+}
+
+/**
+ * @brief   Pop (lr) least recent from buffer (fifo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @param[in] c	Pointer to @p xifo32_p2_t used for configuration.
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_p2_pop_lr(xifo32_p2_t *c){
+    uint32_t *ptemp;
+    uint32_t temp;
+    if(c->count == 0){
+        return 0;	/* Nothing to read there */
+    }
+    ptemp = &c->startpool[(c->head - c->count) & c->mask];
+    temp = *ptemp;
+    /* Empty buffer element */
+    *ptemp = 0;
+    c->count--;
+    return temp;
+}
+
+/**
+ * @brief   Pop (mr) most recent from buffer (filo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @param[in] c   		Pointer to @p xifo32_p2_t used for configuration.
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_p2_pop_mr(xifo32_p2_t *c){
+    uint32_t *ptemp;
+    uint32_t temp;
+    if(c->count == 0){
+        return 0;	/* Nothing to read there */
+    }
+    ptemp = &c->startpool[--c->head & c->mask];
+    temp = *ptemp;
+    /* Empty */
+    *ptemp = 0;
+    c->count--;
+    return temp;
+}
+
+/**
+ * @brief   Get buffer size
+ *
+ * @param[in] c	Pointer to @p xifo32_p2_t used for configuration.
+ *
+ * @return	Size of memory pool in elements
+ */
+uint32_t xifo32_p2_get_size(xifo32_p2_t *c){
+    return c->mask + 1;
+}
+
+/**
+ * @brief   Get amount of used elements
+ *
+ * @param[in] c	Pointer to @p xifo32_p2_t used for configuration.
+ *
+ * @return	Number of elements in buffer
+ */
+uint32_t xifo32_p2_get_used(xifo32_p2_t *c){
+    return c->count;
+}
+
+/**
+ * @brief   Get buffer full flag
+ *
+ * @param[in] c	Pointer to @p xifo32_p2_t used for configuration.
+ *
+ * @return	1 if full, 0 otherwise
+ */
+uint32_t xifo32_p2_get_full(xifo32_p2_t *c){
+    return c->count > c->mask;
+}
+
+/**
+ * @brief   Get amount of free elements
+ *
+ * @param[in] c	Pointer to @p xifo32_p2_t used for configuration.
+ *
+ * @return	Number of free elements in buffer
+ */
+uint32_t xifo32_p2_get_free(xifo32_p2_t *c){
+    return (c->mask + 1) - c->count;
+}
+
+/**
+ * @brief   Slot of the element index positions back from most recent
+ */
+static inline uint32_t xifo32_compact_slot(xifo32_compact_t *c, uint32_t index){
+    uint32_t i = (uint32_t)c->head + c->size - 1 - index;
+    return (i >= c->size) ? (i - c->size) : i;
+}
+
+/**
+ * @brief   Initialize compact buffer object structure.
+ *
+ * @note    Does not clear memory pool.
+ *
+ * @details A size above 65535 is limited to 65535.
+ *
+ * @param[in] c   Pointer to @p xifo32_compact_t object used for configuration.
+ * @param[in] s   Number of elements buffer can hold (size).
+ * @param[in] sp  Start of pre-allocated memory pool.
+ */
+void xifo32_compact_init(xifo32_compact_t *c, uint32_t s, uint32_t *sp){
+    if(s > 0xFFFF){
+        s = 0xFFFF;
+    }
+    c->startpool		= sp;
+    c->size 			= (uint16_t)s;
+    c->head 			= 0;
+    c->count            = 0;
+}
+
+/**
+ * @brief   Clear buffer memory pool
+ *
+ * @note    Must be used on initialised buffer object.
+ *
+ * @param[in] c   Pointer to @p xifo32_compact_t object.
+ */
+void xifo32_compact_clear(xifo32_compact_t *c){
+    memset(c->startpool, 0, c->size * sizeof(uint32_t));
+}
+
+/**
+ * @brief   Write to buffer
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @details Adds a value to the buffer.
+ *					Automatically overwrites oldest elements when full.
+ *
+ * @param[in] c			Pointer to @p xifo32_compact_t used for configuration.
+ * @param[in] data	Data to add to buffer
+ *
+ * @return	Number of free buffer elements
+ */
+uint32_t xifo32_compact_write(xifo32_compact_t *c, uint32_t data){
+    uint32_t head = c->head;
+    c->startpool[head] = data;
+    if(++head >= c->size){
+        head = 0;
+    }
+    c->head = (uint16_t)head;
+    if(c->count < c->size){
+        c->count++;
+    }
+    return (uint32_t)c->size - c->count;
+}
+
+/**
+ * @brief   Read from buffer (lr) Least Recent oriented (fifo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @param[in] c   		Pointer to @p xifo32_compact_t used for configuration.
+ * @param[in] index   Index relative from least recent
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_compact_read_lr(xifo32_compact_t *c, uint32_t index){
+    if(index >= c->count){
+        return 0;	/* Nothing to read there */
+    }
+    return c->startpool[xifo32_compact_slot(c, (c->count - 1) - index)];
+}
+
+/**
+ * @brief   Read from buffer (mr) Most Recent oriented (filo)
+ *
+ * @note    Buffer state will be preserved
+ *
+ * @param[in] c   		Pointer to @p xifo32_compact_t used for configuration.
+ * @param[in] index   Index relative from most recent
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_compact_read_mr(xifo32_compact_t *c, uint32_t index){
+    if(index >= c->count){
+        return 0;	/* Nothing to read there */
+    }
+    return c->startpool[xifo32_compact_slot(c, index)];
+}
+
+/**
+ * @brief   Pop (lr) least recent from buffer (fifo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @param[in] c	Pointer to @p xifo32_compact_t used for configuration.
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_compact_pop_lr(xifo32_compact_t *c){
+    uint32_t *ptemp;
+    uint32_t temp;
+    if(c->count == 0){
+        return 0;	/* Nothing to read there */
+    }
+    ptemp = &c->startpool[xifo32_compact_slot(c, c->count - 1)];
+    temp = *ptemp;
+    /* Empty buffer element */
+    *ptemp = 0;
+    c->count--;
+    return temp;
+}
+
+/**
+ * @brief   Pop (mr) most recent from buffer (filo)
+ *
+ * @note    Buffer state will be altered
+ *
+ * @warning	Consider this opertaion as atomic!
+ *
+ * @param[in] c   		Pointer to @p xifo32_compact_t used for configuration.
+ *
+ * @return	Contents of element or 0 if failed (element can hold 0)
+ */
+uint32_t xifo32_compact_pop_mr(xifo32_compact_t *c){
+    uint32_t *ptemp;
+    uint32_t temp;
+    uint32_t slot;
+    if(c->count == 0){
+        return 0;	/* Nothing to read there */
+    }
+    slot = xifo32_compact_slot(c, 0);
+    ptemp = &c->startpool[slot];
+    temp = *ptemp;
+    /* Empty */
+    *ptemp = 0;
+    /* Most recent element read, return write index */
+    c->head = (uint16_t)slot;
+    c->count--;
+    return temp;
+}
+
+/**
+ * @brief   Get buffer size
+ *
+ * @param[in] c	Pointer to @p xifo32_compact_t used for configuration.
+ *
+ * @return	Size of memory pool in elements
+ */
+uint32_t xifo32_compact_get_size(xifo32_compact_t *c){
+    return c->size;
+}
+
+/**
+ * @brief   Get amount of used elements
+ *
+ * @param[in] c	Pointer to @p xifo32_compact_t used for configuration.
+ *
+ * @return	Number of elements in buffer
+ */
+uint32_t xifo32_compact_get_used(xifo32_compact_t *c){
+    return c->count;
+}
+
+/**
+ * @brief   Get buffer full flag
+ *
+ * @param[in] c	Pointer to @p xifo32_compact_t used for configuration.
+ *
+ * @return	1 if full, 0 otherwise
+ */
+uint32_t xifo32_compact_get_full(xifo32_compact_t *c){
+    return c->count >= c->size;
+}
+
+/**
+ * @brief   Get amount of free elements
+ *
+ * @param[in] c	Pointer to @p xifo32_compact_t used for configuration.
+ *
+ * @return	Number of free elements in buffer
+ */
+uint32_t xifo32_compact_get_free(xifo32_compact_t *c){
+    return (uint32_t)c->size - c->count;
+}
+
 /** @} */
 #endif
\ No newline at end of file
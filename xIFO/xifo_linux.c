@@ -0,0 +1,183 @@
+/**
+ * @file    xifo_linux.c
+ * @brief   xifo Linux host support
+ * @details Futex based sleeping for the blocking calls of the lock-free
+ *          variants. Only built when xIFO_USE_LINUX is enabled.
+ *
+ * @Author	Jeroen Lodder
+ * @Date	March 2014
+ * @version 3
+ * 
+ * Copyright (c) 2014 Jeroen Lodder
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * @{
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "xifo.h"
+
+#if xIFO_USE_LINUX == TRUE
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+
+/**
+ * @brief   Get monotonic time
+ *
+ * @return	Milliseconds since an arbitrary point, wraps
+ */
+uint32_t xifo_time_ms(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec * 1000UL + (uint32_t)(ts.tv_nsec / 1000000L);
+}
+
+/**
+ * @brief   Sleep while a 32 bit word holds the expected value
+ *
+ * @note    May return early (signal, spurious wake up), callers re-check.
+ *
+ * @param[in] word      Word to wait on
+ * @param[in] expected  Value the word had when the caller decided to sleep
+ * @param[in] timeout   Timeout in milliseconds or xIFO_WAIT_FOREVER
+ */
+void xifo_futex_wait(void *word, uint32_t expected, uint32_t timeout){
+    struct timespec ts;
+    ts.tv_sec 			= timeout / 1000UL;
+    ts.tv_nsec			= (long)(timeout % 1000UL) * 1000000L;
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected,
+            (timeout == xIFO_WAIT_FOREVER) ? NULL : &ts, NULL, 0);
+}
+
+/**
+ * @brief   Wake threads sleeping on a word
+ *
+ * @param[in] word      Word the threads wait on
+ * @param[in] count     Maximum number of threads to wake
+ */
+void xifo_futex_wake(void *word, uint32_t count){
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, (count > 0x7FFFFFFFUL) ? 0x7FFFFFFF : (int)count, NULL, NULL, 0);
+}
+
+/**
+ * @brief   Create a non-blocking eventfd to use as doorbell
+ *
+ * @return	File descriptor or -1 on error
+ */
+int xifo_eventfd_open(void){
+    return eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+/**
+ * @brief   Ring a doorbell
+ *
+ * @param[in] fd        eventfd
+ */
+void xifo_eventfd_signal(int fd){
+    uint64_t one = 1;
+    /* Only fails when the counter would overflow, it is readable anyway */
+    if(write(fd, &one, sizeof(one)) < 0){
+        return;
+    }
+}
+
+/**
+ * @brief   Clear a doorbell after wake up
+ *
+ * @param[in] fd        eventfd
+ */
+void xifo_eventfd_ack(int fd){
+    uint64_t count;
+    /* EAGAIN when nothing was signalled */
+    if(read(fd, &count, sizeof(count)) < 0){
+        return;
+    }
+}
+
+/**
+ * @brief   Get the granularity of a mirrored pool
+ *
+ * @return	Pool size in bytes must be a multiple of this (the page size)
+ */
+uint32_t xifo_mirror_granularity(void){
+    return (uint32_t)sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief   Allocate a memory pool that is mapped twice, back to back
+ *
+ * @details pool[bytes + i] is the same memory as pool[i], so any window of
+ *					at most bytes starting inside the pool is contiguous, also when
+ *					it crosses the end. Use it as pool for any xifo type.
+ *
+ * @param[in] bytes     Pool size, a multiple of xifo_mirror_granularity()
+ *
+ * @return	Pool (zeroed) or NULL on error
+ */
+void *xifo_mirror_alloc(uint32_t bytes){
+    uint8_t *base;
+    int fd;
+    if(bytes == 0 || bytes % xifo_mirror_granularity()){
+        return NULL;
+    }
+    fd = (int)syscall(SYS_memfd_create, "xifo", 1U /* MFD_CLOEXEC */);
+    if(fd < 0){
+        return NULL;
+    }
+    if(ftruncate(fd, bytes) < 0){
+        close(fd);
+        return NULL;
+    }
+    /* Reserve address space for both views, then map the file into it twice */
+    base = mmap(NULL, (size_t)bytes * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(base == MAP_FAILED){
+        close(fd);
+        return NULL;
+    }
+    if(mmap(base, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+       mmap(base + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED){
+        munmap(base, (size_t)bytes * 2);
+        close(fd);
+        return NULL;
+    }
+    /* The mappings keep the memory alive */
+    close(fd);
+    return base;
+}
+
+/**
+ * @brief   Release a pool from xifo_mirror_alloc
+ *
+ * @param[in] pool      Pool
+ * @param[in] bytes     Pool size as passed to xifo_mirror_alloc
+ */
+void xifo_mirror_free(void *pool, uint32_t bytes){
+    if(pool){
+        munmap(pool, (size_t)bytes * 2);
+    }
+}
+
+/** @} */
+#endif